@@ -0,0 +1,79 @@
+#version 410 core
+
+in vec2 TexCoords;
+
+out vec4 FragColor;
+
+uniform sampler2D gAlbedo;
+uniform sampler2D gNormal;
+uniform sampler2D gDepth;
+
+// filled by LightGrid on the CPU every frame
+uniform samplerBuffer lightData;     // 2 texels per light: (position, radius) (color, intensity)
+uniform usamplerBuffer clusterRanges;   // (offset, count) into lightIndices per screen tile
+uniform usamplerBuffer lightIndices;
+uniform int tileSize;
+uniform int tileCountX;
+
+uniform mat4 inverseViewProjection;
+uniform vec3 viewPos;
+uniform vec3 lightPos;
+uniform vec3 lightColor;
+
+// diffuse + specular terms of phong_frag_shader
+vec3 Shade(vec3 norm, vec3 viewDir, vec3 lightDir, vec3 color)
+{
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+    return (diff + 0.5 * spec) * color;
+}
+
+void main()
+{
+    float depth = texture(gDepth, TexCoords).r;
+    if (depth == 1.0)
+        discard; // nothing was drawn here, keep skybox and orbits
+
+    gl_FragDepth = depth;
+    vec4 albedo = texture(gAlbedo, TexCoords);
+
+    if (albedo.a > 0.5)
+    {
+        FragColor = vec4(albedo.rgb * lightColor, 1.0);
+        return;
+    }
+
+    // rebuild the world position from depth
+    vec4 clipPos = vec4(TexCoords * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 worldPos = inverseViewProjection * clipPos;
+    vec3 fragPos = worldPos.xyz / worldPos.w;
+
+    vec3 norm = normalize(texture(gNormal, TexCoords).xyz);
+    vec3 viewDir = normalize(viewPos - fragPos);
+
+    // Sun
+    vec3 lighting = 0.2 * lightColor + Shade(norm, viewDir, normalize(lightPos - fragPos), lightColor);
+
+    // point lights binned into this pixel's tile
+    ivec2 tile = ivec2(gl_FragCoord.xy) / tileSize;
+    uvec2 range = texelFetch(clusterRanges, tile.y * tileCountX + tile.x).xy;
+    for (uint i = 0u; i < range.y; i++)
+    {
+        int lightIndex = int(texelFetch(lightIndices, int(range.x + i)).r);
+        vec4 positionRadius = texelFetch(lightData, lightIndex * 2);
+        vec4 colorIntensity = texelFetch(lightData, lightIndex * 2 + 1);
+
+        vec3 toLight = positionRadius.xyz - fragPos;
+        float dist = length(toLight);
+        if (dist >= positionRadius.w)
+            continue;
+
+        // smooth falloff reaching zero at the light radius
+        float falloff = 1.0 - (dist * dist) / (positionRadius.w * positionRadius.w);
+        falloff *= falloff;
+        lighting += Shade(norm, viewDir, toLight / dist, colorIntensity.rgb) * colorIntensity.a * falloff;
+    }
+
+    FragColor = vec4(lighting * albedo.rgb, 1.0);
+}
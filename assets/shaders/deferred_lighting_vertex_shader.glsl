@@ -0,0 +1,11 @@
+#version 410 core
+
+out vec2 TexCoords;
+
+void main()
+{
+    // fullscreen triangle: (0,0) (2,0) (0,2) in UV space, no vertex buffer needed
+    vec2 uv = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    TexCoords = uv;
+    gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,6 @@
+#version 410 core
+
+// depth pre-pass, color writes are masked off
+void main()
+{
+}
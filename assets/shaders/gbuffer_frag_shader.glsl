@@ -0,0 +1,17 @@
+#version 410 core
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoords;
+
+layout (location = 0) out vec4 gAlbedo; // rgb = texture, a = 1 for emissive (Sun)
+layout (location = 1) out vec4 gNormal;
+
+uniform sampler2D planetTexture;
+uniform int isSun;
+
+void main()
+{
+    gAlbedo = vec4(texture(planetTexture, TexCoords).rgb, isSun == 1 ? 1.0 : 0.0);
+    gNormal = vec4(normalize(Normal), 0.0);
+}
@@ -8,6 +8,7 @@ out vec3 FragColor; // Pass final color to the fragment shader
 out vec2 TexCoords;
 
 uniform mat4 model;
+uniform mat3 normalMatrix;
 uniform mat4 view;
 uniform mat4 projection;
 uniform vec3 lightPos;
@@ -18,7 +19,7 @@ uniform int isSun;
 void main()
 {
     vec3 FragPos = vec3(model * vec4(aPos, 1.0));
-    vec3 Normal = mat3(transpose(inverse(model))) * aNormal;
+    vec3 Normal = normalMatrix * aNormal;
     TexCoords = aTexCoords;
 
     vec3 textureColor = vec3(1.0); // Placeholder, texture applied in the fragment shader
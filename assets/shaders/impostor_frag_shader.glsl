@@ -0,0 +1,108 @@
+#version 410 core
+
+in vec3 WorldPos;
+flat in vec3 Center;
+flat in float Radius;
+flat in mat3 BodyRotation;
+flat in int IsSun;
+
+out vec4 FragColor;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform sampler2D planetTexture;
+uniform vec3 lightPos;
+uniform vec3 viewPos;
+uniform vec3 lightColor;
+
+// point lights from the active LightGrid, froxels in forward mode and a single slice in deferred mode
+uniform samplerBuffer lightData;     // 2 texels per light: (position, radius) (color, intensity)
+uniform usamplerBuffer clusterRanges; // (offset, count) into lightIndices per cluster
+uniform usamplerBuffer lightIndices;
+uniform int tileSize;
+uniform ivec2 tileCount;
+uniform int depthSlices;
+uniform vec2 sliceScaleBias; // slice = log(viewDepth) * scale + bias
+
+const float PI = 3.14159265359;
+
+// same loop as phong_frag_shader.glsl, so bodies keep their lighting when they switch to impostors
+vec3 PointLights(vec3 position, vec3 norm, vec3 viewDir)
+{
+    float viewDepth = -(view * vec4(position, 1.0)).z;
+    int slice = clamp(int(log(viewDepth) * sliceScaleBias.x + sliceScaleBias.y), 0, depthSlices - 1);
+    ivec2 tile = min(ivec2(gl_FragCoord.xy) / tileSize, tileCount - 1);
+    uvec2 range = texelFetch(clusterRanges, (slice * tileCount.y + tile.y) * tileCount.x + tile.x).xy;
+
+    vec3 lighting = vec3(0.0);
+    for (uint i = 0u; i < range.y; i++)
+    {
+        int lightIndex = int(texelFetch(lightIndices, int(range.x + i)).r);
+        vec4 positionRadius = texelFetch(lightData, lightIndex * 2);
+        vec4 colorIntensity = texelFetch(lightData, lightIndex * 2 + 1);
+
+        vec3 toLight = positionRadius.xyz - position;
+        float dist = length(toLight);
+        if (dist >= positionRadius.w)
+            continue;
+
+        vec3 lightDir = toLight / dist;
+        float diff = max(dot(norm, lightDir), 0.0);
+        float spec = pow(max(dot(viewDir, reflect(-lightDir, norm)), 0.0), 32);
+
+        // smooth falloff reaching zero at the light radius
+        float falloff = 1.0 - (dist * dist) / (positionRadius.w * positionRadius.w);
+        lighting += (diff + 0.5 * spec) * colorIntensity.rgb * colorIntensity.a * falloff * falloff;
+    }
+    return lighting;
+}
+
+void main()
+{
+    // ray / sphere intersection from the camera through this fragment
+    vec3 rayDir = normalize(WorldPos - viewPos);
+    vec3 oc = viewPos - Center;
+    float b = dot(oc, rayDir);
+    float c = dot(oc, oc) - Radius * Radius;
+    float h = b * b - c;
+    if (h < 0.0)
+        discard;
+
+    vec3 hitPos = viewPos + (-b - sqrt(h)) * rayDir;
+    vec3 norm = (hitPos - Center) / Radius;
+
+    // real sphere depth so impostors intersect meshes and orbit lines correctly
+    vec4 clipPos = projection * view * vec4(hitPos, 1.0);
+    gl_FragDepth = 0.5 * (gl_DepthRange.diff * (clipPos.z / clipPos.w) + gl_DepthRange.near + gl_DepthRange.far);
+
+    // same UV mapping as SolarSystemLayer::GenerateSphere, in the body's local frame
+    vec3 localNormal = transpose(BodyRotation) * norm;
+    float s = atan(localNormal.y, localNormal.x) / (2.0 * PI);
+    float t = (PI / 2.0 - asin(clamp(localNormal.z, -1.0, 1.0))) / PI;
+    vec3 textureColor = texture(planetTexture, vec2(fract(s), t)).rgb;
+
+    if (IsSun == 1)
+    {
+        FragColor = vec4(textureColor * lightColor, 1.0);
+        return;
+    }
+
+    // Ambient lighting
+    float ambientStrength = 0.2;
+    vec3 ambient = ambientStrength * lightColor;
+
+    // Diffuse lighting
+    vec3 lightDir = normalize(lightPos - hitPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * lightColor;
+
+    // Specular lighting
+    float specularStrength = 0.5;
+    vec3 viewDir = normalize(viewPos - hitPos);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32); // Shininess factor
+    vec3 specular = specularStrength * spec * lightColor;
+
+    vec3 lighting = ambient + diffuse + specular + PointLights(hitPos, norm, viewDir);
+    FragColor = vec4(lighting * textureColor, 1.0);
+}
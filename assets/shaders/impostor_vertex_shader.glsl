@@ -0,0 +1,42 @@
+#version 410 core
+// camera-facing quad around a sphere, corners from gl_VertexID (GL_TRIANGLE_STRIP, 4 vertices)
+
+// one instance per body, streamed by SolarSystemLayer::DrawImpostors
+layout(location = 0) in vec4 aCenterRadius;
+layout(location = 1) in mat3 aRotation;
+layout(location = 4) in int aIsSun;
+
+out vec3 WorldPos;
+flat out vec3 Center;
+flat out float Radius;
+flat out mat3 BodyRotation;
+flat out int IsSun;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 viewPos;
+
+void main()
+{
+    vec3 center = aCenterRadius.xyz;
+    float radius = aCenterRadius.w;
+    Center = center;
+    Radius = radius;
+    BodyRotation = aRotation;
+    IsSun = aIsSun;
+
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1)) * 2.0 - 1.0;
+
+    // quad faces the camera and is sized to the cross-section of the tangent cone,
+    // so the whole silhouette is covered under perspective
+    vec3 toCamera = viewPos - center;
+    float dist = length(toCamera);
+    vec3 forward = toCamera / dist;
+    vec3 cameraUp = vec3(view[0][1], view[1][1], view[2][1]);
+    vec3 right = normalize(cross(cameraUp, forward));
+    vec3 up = cross(forward, right);
+    float extent = radius * dist / sqrt(max(dist * dist - radius * radius, 1e-6));
+
+    WorldPos = center + (corner.x * right + corner.y * up) * extent;
+    gl_Position = projection * view * vec4(WorldPos, 1.0);
+}
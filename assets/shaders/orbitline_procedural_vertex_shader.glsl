@@ -0,0 +1,18 @@
+#version 410 core
+// one instance per orbit, drawn as GL_LINE_STRIP with segments + 1 vertices
+layout(location = 0) in float aRadius;
+layout(location = 1) in ivec2 aSegments; // x = segment count
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+const float TWO_PI = 6.28318530718;
+
+void main()
+{
+    int segment = min(gl_VertexID, aSegments.x);
+    float angle = float(segment) * TWO_PI / float(aSegments.x);
+    vec3 position = vec3(aRadius * cos(angle), 0.0, aRadius * sin(angle));
+    gl_Position = projection * view * model * vec4(position, 1.0);
+}
@@ -12,6 +12,46 @@ uniform vec3 viewPos;
 uniform vec3 lightColor;
 uniform int isSun;
 
+// clustered point lights, built by LightGrid on the CPU every frame
+uniform mat4 view;
+uniform samplerBuffer lightData;     // 2 texels per light: (position, radius) (color, intensity)
+uniform usamplerBuffer clusterRanges; // (offset, count) into lightIndices per froxel
+uniform usamplerBuffer lightIndices;
+uniform int tileSize;
+uniform ivec2 tileCount;
+uniform int depthSlices;
+uniform vec2 sliceScaleBias; // slice = log(viewDepth) * scale + bias
+
+vec3 PointLights(vec3 norm, vec3 viewDir)
+{
+    float viewDepth = -(view * vec4(FragPos, 1.0)).z;
+    int slice = clamp(int(log(viewDepth) * sliceScaleBias.x + sliceScaleBias.y), 0, depthSlices - 1);
+    ivec2 tile = min(ivec2(gl_FragCoord.xy) / tileSize, tileCount - 1);
+    uvec2 range = texelFetch(clusterRanges, (slice * tileCount.y + tile.y) * tileCount.x + tile.x).xy;
+
+    vec3 lighting = vec3(0.0);
+    for (uint i = 0u; i < range.y; i++)
+    {
+        int lightIndex = int(texelFetch(lightIndices, int(range.x + i)).r);
+        vec4 positionRadius = texelFetch(lightData, lightIndex * 2);
+        vec4 colorIntensity = texelFetch(lightData, lightIndex * 2 + 1);
+
+        vec3 toLight = positionRadius.xyz - FragPos;
+        float dist = length(toLight);
+        if (dist >= positionRadius.w)
+            continue;
+
+        vec3 lightDir = toLight / dist;
+        float diff = max(dot(norm, lightDir), 0.0);
+        float spec = pow(max(dot(viewDir, reflect(-lightDir, norm)), 0.0), 32);
+
+        // smooth falloff reaching zero at the light radius
+        float falloff = 1.0 - (dist * dist) / (positionRadius.w * positionRadius.w);
+        lighting += (diff + 0.5 * spec) * colorIntensity.rgb * colorIntensity.a * falloff * falloff;
+    }
+    return lighting;
+}
+
 void main()
 {
     vec3 textureColor = texture(planetTexture, TexCoords).rgb;
@@ -42,6 +82,6 @@ void main()
     vec3 specular = specularStrength * spec * lightColor;
 
     // Combine all components
-    vec3 lighting = ambient + diffuse + specular;
+    vec3 lighting = ambient + diffuse + specular + PointLights(norm, viewDir);
     FragColor = vec4(lighting * textureColor, 1.0);
 }
@@ -0,0 +1,45 @@
+#version 410 core
+// UV sphere generated from gl_VertexID, drawn as GL_TRIANGLES with sectors * stacks * 6 vertices
+// matches SolarSystemLayer::GenerateSphere (pole quads collapse into degenerate triangles)
+layout (location = 0) in float aRadius;
+layout (location = 1) in ivec2 aSegments; // x = sectors, y = stacks
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoords;
+invariant gl_Position;
+
+uniform mat4 model;
+uniform mat3 normalMatrix;
+uniform mat4 view;
+uniform mat4 projection;
+
+const float PI = 3.14159265359;
+
+// (stack, sector) offsets of the two triangles of a quad
+const ivec2 QUAD_CORNERS[6] = ivec2[6](
+    ivec2(0, 0), ivec2(1, 0), ivec2(0, 1),
+    ivec2(0, 1), ivec2(1, 0), ivec2(1, 1));
+
+void main()
+{
+    int sectors = aSegments.x;
+    int stacks = aSegments.y;
+
+    int quad = gl_VertexID / 6;
+    ivec2 corner = QUAD_CORNERS[gl_VertexID % 6];
+    int stack = quad / sectors + corner.x;
+    int sector = quad % sectors + corner.y;
+
+    float stackAngle = PI / 2.0 - float(stack) * PI / float(stacks);
+    float sectorAngle = float(sector) * 2.0 * PI / float(sectors);
+
+    vec3 unitPos = vec3(cos(stackAngle) * cos(sectorAngle),
+                        cos(stackAngle) * sin(sectorAngle),
+                        sin(stackAngle));
+
+    FragPos = vec3(model * vec4(aRadius * unitPos, 1.0));
+    Normal = normalMatrix * unitPos; // Transform normals to world space
+    TexCoords = vec2(float(sector) / float(sectors), float(stack) / float(stacks));
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
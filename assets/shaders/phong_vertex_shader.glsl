@@ -8,14 +8,18 @@ out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 
+// the depth pre-pass and the color pass must produce bit-identical depth
+invariant gl_Position;
+
 uniform mat4 model;
+uniform mat3 normalMatrix; // transpose(inverse(mat3(model))), computed once per draw on the CPU
 uniform mat4 view;
 uniform mat4 projection;
 
 void main()
 {
     FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal; // Transform normals to world space
+    Normal = normalMatrix * aNormal; // Transform normals to world space
     TexCoords = aTexCoords;
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
@@ -9,5 +9,6 @@ out vec3 v_TexCoords;
 void main()
 {
     v_TexCoords = a_Position;
-    gl_Position = projection * view * vec4(a_Position, 1.0);
+    vec4 position = projection * view * vec4(a_Position, 1.0);
+    gl_Position = position.xyww; // z = w => depth 1.0, always on the far plane
 }
@@ -0,0 +1,101 @@
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// build with -DALLOCATION_TRACKING=0 to drop the global operator new/delete hooks
+#ifndef ALLOCATION_TRACKING
+#define ALLOCATION_TRACKING 1
+#endif
+
+// subsystem an allocation is charged to, set per thread with AllocationScope
+enum class AllocTag : uint8_t
+{
+    Untagged = 0,
+    Update,
+    Render,
+    UI,
+    Events,
+    Audio,
+    Resources,
+    Logging,
+    Count,
+    Untracked // never counted, used for the tracker's own reporting
+};
+
+struct AllocCounters
+{
+    uint64_t allocations;
+    uint64_t frees;
+    uint64_t bytes; // requested bytes, frees are not sized
+};
+
+const char *AllocTagName(AllocTag tag);
+
+/**
+ * Heap allocation counters fed by the global operator new/delete overrides in AllocationTracker.cpp
+ * Only the frame thread (the one that called SetFrameThread, the main loop) is charged to the
+ * frame. Job workers, the log writer and driver/audio threads run on their own schedule, so
+ * they go into separate "background" counters instead of whichever frame happens to be current.
+ * The tag is thread-local, so any thread is charged to whatever scope it opened itself
+ * (Untagged by default).
+ *      EndFrame => snapshots both sets of counters per tag and starts the next frame,
+ *                  called on the frame thread
+ */
+class AllocationTracker
+{
+public:
+    using FrameCounters = std::array<AllocCounters, static_cast<std::size_t>(AllocTag::Count)>;
+
+    static void RecordAllocation(std::size_t size);
+    static void RecordFree();
+
+    static AllocTag GetCurrentTag();
+    static void SetCurrentTag(AllocTag tag);
+
+    // marks the calling thread as the one whose allocations count toward the frame
+    static void SetFrameThread();
+
+    // returns the finished frame's total, frame thread only
+    static AllocCounters EndFrame();
+
+    static const FrameCounters &GetLastFrame() { return s_LastFrame; }
+    static AllocCounters GetLastFrameTotal() { return s_LastFrameTotal; }
+    // every other thread, over the same interval
+    static const FrameCounters &GetLastBackground() { return s_LastBackground; }
+    static AllocCounters GetLastBackgroundTotal() { return s_LastBackgroundTotal; }
+    static uint64_t GetLiveAllocations();
+    static constexpr bool IsEnabled() { return ALLOCATION_TRACKING != 0; }
+
+    // logs where the finished frame allocated, Untracked so the report doesn't count itself
+    static void LogLastFrame(uint64_t frameIndex);
+
+private:
+    static FrameCounters s_LastFrame;
+    static AllocCounters s_LastFrameTotal;
+    static FrameCounters s_LastBackground;
+    static AllocCounters s_LastBackgroundTotal;
+};
+
+// charges every allocation on this thread to 'tag' until the scope ends
+// (inside an Untracked scope everything stays untracked)
+class AllocationScope
+{
+public:
+    explicit AllocationScope(AllocTag tag) : m_Previous(AllocationTracker::GetCurrentTag())
+    {
+        if (m_Previous != AllocTag::Untracked)
+            AllocationTracker::SetCurrentTag(tag);
+    }
+    ~AllocationScope() { AllocationTracker::SetCurrentTag(m_Previous); }
+
+    AllocationScope(const AllocationScope &) = delete;
+    AllocationScope &operator=(const AllocationScope &) = delete;
+
+private:
+    AllocTag m_Previous;
+};
+
+#endif
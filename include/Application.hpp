@@ -5,12 +5,21 @@
 #include "LayerStack.hpp"
 #include "events/Event.hpp"
 #include "events/WindowEvent.hpp"
+#include "events/EventQueue.hpp"
+#include "Input.hpp"
+#include "InputRecording.hpp"
+#include "Benchmark.hpp"
+#include "GpuProfiler.hpp"
+#include "FrameStats.hpp"
+#include "FrameArena.hpp"
+#include "JobSystem.hpp"
+#include "ResourceManager.hpp"
 #include <memory>
 
 class Application
 {
 public:
-    Application();
+    Application(int argc = 0, char **argv = nullptr);
     virtual ~Application();
 
     void Run();
@@ -22,12 +31,37 @@ public:
 
     LayerStack &GetLayerStack() { return m_LayerStack; }
 
+    // nullptr unless started with --benchmark
+    Benchmark *GetBenchmark() const { return m_Benchmark.get(); }
+
+    // non-zero when a benchmark assertion failed
+    int GetExitCode() const { return m_ExitCode; }
+
+    GpuProfiler &GetGpuProfiler() { return *m_GpuProfiler; }
+    FrameStats &GetFrameStats() { return m_FrameStats; }
+    FrameArena &GetFrameArena() { return m_FrameArena; }
+    JobSystem &GetJobSystem() { return *m_JobSystem; }
+    ResourceManager &GetResourceManager() { return *m_ResourceManager; }
+    EventQueue &GetEventQueue() { return m_EventQueue; }
+    const Input &GetInput() const { return m_Input; }
+
 private:
     bool m_Running = true;
     bool m_Minimized = false;
     float m_LastFrameTime = 0.0f;
+    int m_ExitCode = 0;
 
     std::unique_ptr<Window> m_Window;
+    std::unique_ptr<Benchmark> m_Benchmark;
+    std::unique_ptr<InputRecorder> m_InputRecorder;
+    std::unique_ptr<InputReplay> m_InputReplay;
+    std::unique_ptr<GpuProfiler> m_GpuProfiler;
+    FrameStats m_FrameStats;
+    FrameArena m_FrameArena;
+    EventQueue m_EventQueue;
+    Input m_Input;
+    std::unique_ptr<JobSystem> m_JobSystem; // declared before the layers so it outlives them
+    std::unique_ptr<ResourceManager> m_ResourceManager; // layers release their handles on detach
 
     LayerStack m_LayerStack;
     static Application *s_Instance;
@@ -0,0 +1,75 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AllocationTracker.hpp"
+#include "CameraPath.hpp"
+
+struct BenchmarkProps
+{
+    uint32_t frames; // 0 with a camera path = as many frames as the path lasts
+    uint32_t warmupFrames;
+    std::string outputPath;
+    bool assertNoAllocations; // --assert-no-alloc, measured frames must not touch the heap
+    std::string cameraPath;   // --camera-path file, flown instead of user input
+    float fixedTimestep;      // seconds of simulation per frame while flying a camera path
+
+    BenchmarkProps()
+        : frames(1000), warmupFrames(60), outputPath("bench_output.txt"), assertNoAllocations(false),
+          fixedTimestep(1.0f / 60.0f)
+    {
+    }
+};
+
+/**
+ * Fixed-length benchmark run (./macos-opengl --benchmark [frames] [--assert-no-alloc])
+ *      - vsync is disabled and every frame ends with glFinish so GPU cost shows up in the frame time
+ *      - warmup frames (shader compilation, texture uploads) are excluded
+ *      - the summary is logged and written to BenchmarkProps::outputPath
+ *      - with assertNoAllocations any heap allocation in a measured frame fails the run
+ *      - with a camera path (--camera-path file) the camera flies the path and the simulation
+ *        advances by a fixed timestep, so every run renders the same frames; results are also
+ *        split by the path's sections
+ */
+class Benchmark
+{
+public:
+    Benchmark(const BenchmarkProps &props = BenchmarkProps());
+    ~Benchmark() = default;
+
+    void AddFrame(float deltaTime, const AllocCounters &allocations);
+    bool IsFinished() const;
+
+    // returns false when the run failed an assertion
+    bool Report() const;
+
+    inline uint32_t GetFrameIndex() const { return m_FrameIndex; }
+    inline const BenchmarkProps &GetProps() const { return m_Props; }
+    inline const CameraPath *GetCameraPath() const { return m_CameraPath.get(); }
+    // where on the camera path the current frame is, warmup frames hold the start pose
+    inline float GetCameraPathTime() const { return GetCameraPathTime(m_FrameIndex); }
+
+    // returns nullptr when --benchmark is not on the command line
+    // also reads --camera-path file, [frames] defaults to the path's length then
+    static std::unique_ptr<Benchmark> FromCommandLine(int argc, char **argv);
+
+private:
+    float GetCameraPathTime(uint32_t frameIndex) const;
+
+private:
+    BenchmarkProps m_Props;
+    std::shared_ptr<CameraPath> m_CameraPath;
+    uint32_t m_FrameIndex;
+    std::vector<float> m_FrameTimes; // seconds, warmup excluded
+    std::vector<uint32_t> m_FrameSections; // camera path section of each measured frame
+
+    uint64_t m_TotalAllocations;
+    uint64_t m_MaxAllocations;
+    uint64_t m_BackgroundAllocations; // other threads, reported but not asserted on
+    uint32_t m_AllocatingFrames;
+};
+
+#endif
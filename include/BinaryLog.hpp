@@ -0,0 +1,158 @@
+#ifndef BINARY_LOG_HPP
+#define BINARY_LOG_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "Logger.hpp"
+#include "Profiler.hpp"
+
+// tag in front of every encoded argument
+enum class BinaryArgType : uint8_t
+{
+    Int = 0,    // int64
+    UInt = 1,   // uint64
+    Double = 2, // float64
+    Bool = 3,   // uint8
+    String = 4  // uint16 length + bytes, no terminator
+};
+
+/**
+ * Binary diagnostic log, formatting happens offline (scripts/decode_binary_log.py)
+ * A record is only the format-string ID, a timestamp and the raw arguments, appended to a
+ * per-thread buffer. Full buffers are written to the file as chunks together with any format
+ * strings registered since the last chunk, so the file decodes front to back.
+ *
+ * Use the LOG_BINARY macro, it registers each call site's format string once.
+ * Does nothing until Open is called (--binary-log).
+ */
+class BinaryLog
+{
+public:
+    static constexpr std::size_t THREAD_BUFFER_SIZE = 64 * 1024;
+    static constexpr std::size_t MAX_STRING_LENGTH = 0xFFFF;
+
+    static bool Open(const std::string &path);
+    // writes out every thread's buffer, other threads may keep logging (their records are dropped)
+    static void Close();
+    static bool IsOpen() { return s_Open.load(std::memory_order_relaxed); }
+
+    static uint32_t RegisterFormat(int level, const char *format, const char *file, int line);
+
+    template <typename... Args>
+    static void Write(uint32_t formatID, const Args &...args)
+    {
+        if (!IsOpen())
+            return;
+
+        std::size_t size = RECORD_HEADER_SIZE + (std::size_t{0} + ... + EncodedSize(args));
+        ThreadBuffer &buffer = GetThreadBuffer();
+        unsigned char *out = Reserve(buffer, size);
+        if (!out)
+            return;
+
+        uint64_t timestamp = Profiler::Now();
+        out = Put(out, formatID);
+        out = Put(out, timestamp);
+        *out++ = static_cast<uint8_t>(sizeof...(Args));
+        ((out = Encode(out, args)), ...);
+        Commit(buffer, size);
+    }
+
+    // per-thread record buffer, defined in BinaryLog.cpp
+    struct ThreadBuffer;
+
+private:
+    static constexpr std::size_t RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint8_t);
+
+    static ThreadBuffer &GetThreadBuffer();
+    // locks the buffer and returns space for 'size' bytes (flushing it first if full), nullptr if closed
+    static unsigned char *Reserve(ThreadBuffer &buffer, std::size_t size);
+    static void Commit(ThreadBuffer &buffer, std::size_t size);
+
+    template <typename T>
+    static unsigned char *Put(unsigned char *out, const T &value)
+    {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+
+    static std::size_t StringLength(const char *text) { return std::min(std::strlen(text), MAX_STRING_LENGTH); }
+
+    template <typename T>
+    static std::size_t EncodedSize(const T &value)
+    {
+        if constexpr (std::is_convertible_v<const T &, const char *>)
+            return 1 + sizeof(uint16_t) + StringLength(value);
+        else if constexpr (std::is_same_v<T, std::string>)
+            return 1 + sizeof(uint16_t) + std::min(value.size(), MAX_STRING_LENGTH);
+        else if constexpr (std::is_same_v<T, bool>)
+            return 1 + sizeof(uint8_t);
+        else
+        {
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "BinaryLog only records numbers, bools and strings");
+            return 1 + sizeof(uint64_t);
+        }
+    }
+
+    template <typename T>
+    static unsigned char *Encode(unsigned char *out, const T &value)
+    {
+        if constexpr (std::is_convertible_v<const T &, const char *> || std::is_same_v<T, std::string>)
+        {
+            const char *text;
+            uint16_t length;
+            if constexpr (std::is_same_v<T, std::string>)
+                text = value.data(), length = static_cast<uint16_t>(std::min(value.size(), MAX_STRING_LENGTH));
+            else
+                text = value, length = static_cast<uint16_t>(StringLength(value));
+            *out++ = static_cast<uint8_t>(BinaryArgType::String);
+            out = Put(out, length);
+            std::memcpy(out, text, length);
+            return out + length;
+        }
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            *out++ = static_cast<uint8_t>(BinaryArgType::Bool);
+            *out++ = value ? 1 : 0;
+            return out;
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            *out++ = static_cast<uint8_t>(BinaryArgType::Double);
+            return Put(out, static_cast<double>(value));
+        }
+        else if constexpr (std::is_enum_v<T> || std::is_signed_v<T>)
+        {
+            *out++ = static_cast<uint8_t>(BinaryArgType::Int);
+            return Put(out, static_cast<int64_t>(value));
+        }
+        else
+        {
+            *out++ = static_cast<uint8_t>(BinaryArgType::UInt);
+            return Put(out, static_cast<uint64_t>(value));
+        }
+    }
+
+    static std::atomic<bool> s_Open;
+};
+
+/**
+ * LOG_BINARY(spdlog::level::debug, "mouse {} {}", x, y)
+ * Compiled out below LOG_ACTIVE_LEVEL like the Logger wrappers, the format string must be a literal
+ */
+#define LOG_BINARY(level, format, ...)                                                                      \
+    do                                                                                                      \
+    {                                                                                                       \
+        if constexpr (LOG_ACTIVE_LEVEL <= (level))                                                          \
+        {                                                                                                   \
+            static const uint32_t binaryLogFormat = BinaryLog::RegisterFormat(level, format, __FILE__, __LINE__); \
+            BinaryLog::Write(binaryLogFormat, ##__VA_ARGS__);                                               \
+        }                                                                                                   \
+    } while (0)
+
+#endif
@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 #include <OpenGL/gl3.h>
 #include <GLFW/glfw3.h>
+#include "Input.hpp"
 
 class Camera
 {
@@ -14,8 +15,11 @@ public:
     ~Camera() = default;
 
     glm::mat4 GetViewMatrix() const;
-    void ProcessInput();
+    // once per frame, speeds are per second so motion doesn't depend on the frame rate
+    void ProcessInput(const Input &input, float deltaTime);
     void ProcessMouseMovement(float xOffset, float yOffset);
+    // scripted placement (camera paths), pitch is clamped like mouse look
+    void SetPose(const glm::vec3 &position, float yaw, float pitch);
 
     const inline glm::vec3 &GetPosition() const { return m_Position; }
     const inline glm::vec3 &GetFront() const { return m_Front; }
@@ -43,8 +47,8 @@ private:
 
     float m_Yaw;
     float m_Pitch;
-    float m_Speed;
-    float m_RotationSpeed;
+    float m_Speed;         // units per second
+    float m_RotationSpeed; // degrees per second
     float m_Sensitivity;
 };
 
@@ -0,0 +1,56 @@
+#ifndef CAMERA_PATH_HPP
+#define CAMERA_PATH_HPP
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct CameraKeyframe
+{
+    float time; // seconds from the start of the path
+    glm::vec3 position;
+    float yaw;
+    float pitch;
+    uint32_t section; // index into CameraPath::GetSections
+};
+
+struct CameraPose
+{
+    glm::vec3 position;
+    float yaw;
+    float pitch;
+};
+
+/**
+ * Scripted camera track, Catmull-Rom through the keyframes (position, yaw, pitch)
+ * Text file, one keyframe per line, '#' starts a comment:
+ *      time  x y z  yaw pitch  [section]
+ * A section name starts a named stretch of the path (benchmark results are split by section),
+ * keyframes without one stay in the current section. Yaw is not wrapped, write it continuously.
+ */
+class CameraPath
+{
+public:
+    explicit CameraPath(const std::string &path);
+
+    // clamped to the first / last keyframe outside the path's time range
+    CameraPose Evaluate(float time) const;
+    uint32_t GetSectionIndex(float time) const;
+
+    inline float GetDuration() const { return m_Keyframes.back().time; }
+    inline const std::vector<CameraKeyframe> &GetKeyframes() const { return m_Keyframes; }
+    inline const std::vector<std::string> &GetSections() const { return m_Sections; }
+
+    static std::shared_ptr<CameraPath> Create(const std::string &path);
+
+private:
+    // index of the keyframe that starts the span containing 'time'
+    std::size_t FindSpan(float time) const;
+
+private:
+    std::vector<CameraKeyframe> m_Keyframes;
+    std::vector<std::string> m_Sections;
+};
+
+#endif
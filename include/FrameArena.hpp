@@ -0,0 +1,106 @@
+#ifndef FRAME_ARENA_HPP
+#define FRAME_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Bump allocator over one fixed block, individual frees are no-ops and Reset releases everything
+ * Allocate is lock-free (atomic bump) so worker threads can share it.
+ * Running out of space throws like StreamingBuffer does, raise the capacity instead of growing.
+ */
+class LinearArena
+{
+public:
+    explicit LinearArena(std::size_t capacity);
+    ~LinearArena() = default;
+
+    LinearArena(const LinearArena &) = delete;
+    LinearArena &operator=(const LinearArena &) = delete;
+
+    void *Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+    void Reset();
+
+    inline std::size_t GetUsed() const { return m_Head.load(std::memory_order_relaxed); }
+    inline std::size_t GetPeak() const { return m_Peak; }
+    inline std::size_t GetCapacity() const { return m_Capacity; }
+
+private:
+    std::unique_ptr<unsigned char[]> m_Memory;
+    std::size_t m_Capacity;
+    std::atomic<std::size_t> m_Head;
+    std::size_t m_Peak; // highest m_Head seen at Reset
+};
+
+/**
+ * Transient per-frame memory, double buffered
+ *      BeginFrame => switches to the other arena and resets it (called at the top of Application::Run)
+ * Memory handed out in frame N stays valid through frame N + 1, so data can be consumed
+ * one frame late (render queues handed to another thread, GPU uploads) without copying.
+ */
+class FrameArena
+{
+public:
+    static constexpr uint32_t BUFFER_COUNT = 2;
+
+    explicit FrameArena(std::size_t capacityPerFrame = 4 * 1024 * 1024);
+
+    void BeginFrame();
+
+    inline void *Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t))
+    {
+        return m_Arenas[m_Current]->Allocate(size, alignment);
+    }
+
+    inline const LinearArena &GetCurrent() const { return *m_Arenas[m_Current]; }
+
+private:
+    std::unique_ptr<LinearArena> m_Arenas[BUFFER_COUNT];
+    uint32_t m_Current;
+};
+
+// STL allocator over a FrameArena, deallocate is a no-op
+template <typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+    // containers adopt the allocator of whatever they are assigned from (the new frame's arena)
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit FrameAllocator(FrameArena &arena) : m_Arena(&arena) {}
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U> &other) : m_Arena(other.GetArena())
+    {
+    }
+
+    T *allocate(std::size_t count)
+    {
+        return static_cast<T *>(m_Arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, std::size_t) {}
+
+    inline FrameArena *GetArena() const { return m_Arena; }
+
+private:
+    FrameArena *m_Arena;
+};
+
+template <typename T, typename U>
+inline bool operator==(const FrameAllocator<T> &a, const FrameAllocator<U> &b) { return a.GetArena() == b.GetArena(); }
+
+template <typename T, typename U>
+inline bool operator!=(const FrameAllocator<T> &a, const FrameAllocator<U> &b) { return !(a == b); }
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef FRAME_STATS_HPP
+#define FRAME_STATS_HPP
+
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl3.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+struct FrameSample
+{
+    float frameMs; // time since the previous frame started
+    float cpuMs;   // BeginFrame -> EndFrame, excludes swap / vsync
+    float gpuMs;   // sum of GpuProfiler passes, a few frames late
+    uint32_t drawCalls;
+    uint32_t triangles;
+    uint32_t uniformUploads;
+};
+
+/**
+ * Fixed-size frame history with rolling percentiles, a frame time histogram and a hitch detector
+ * All storage is inline, nothing is allocated after construction.
+ * Render code reports work through the static Count* functions (main thread only),
+ * the counters are reset at BeginFrame.
+ */
+class FrameStats
+{
+public:
+    static constexpr uint32_t HISTORY_SIZE = 512;
+    static constexpr uint32_t HISTOGRAM_BUCKETS = 32;
+
+    FrameStats(float hitchBudgetMs = 1000.0f / 30.0f);
+    ~FrameStats() = default;
+
+    void BeginFrame();
+    void EndFrame(float frameMs, float gpuMs);
+
+    static void CountDraw(GLenum mode, GLsizei vertexCount, GLsizei instanceCount = 1);
+    static void CountDrawCalls(uint32_t drawCalls, uint32_t triangles);
+    static void CountUniformUpload() { s_UniformUploads++; }
+
+    inline const FrameSample &GetLastSample() const { return m_Samples[(m_Head + HISTORY_SIZE - 1) % HISTORY_SIZE]; }
+    inline uint32_t GetSampleCount() const { return m_Count; }
+
+    // frame time percentiles over the history, refreshed every EndFrame
+    inline float GetP50() const { return m_P50; }
+    inline float GetP95() const { return m_P95; }
+    inline float GetP99() const { return m_P99; }
+    inline float GetAverageFrameMs() const { return m_Count ? m_FrameTimeSum / m_Count : 0.0f; }
+
+    // ring of frame times for plotting, oldest sample at GetHistoryOffset()
+    inline const std::array<float, HISTORY_SIZE> &GetFrameTimes() const { return m_FrameTimes; }
+    inline uint32_t GetHistoryOffset() const { return m_Head; }
+
+    // frame counts per bucket over [0, 2 * budget), the last bucket also holds slower frames
+    inline const std::array<float, HISTOGRAM_BUCKETS> &GetHistogram() const { return m_Histogram; }
+    inline float GetHistogramRangeMs() const { return m_HitchBudgetMs * 2.0f; }
+
+    void SetHitchBudget(float budgetMs);
+    inline float GetHitchBudget() const { return m_HitchBudgetMs; }
+    inline uint32_t GetHitchCount() const { return m_HitchCount; }
+
+private:
+    uint32_t GetBucket(float frameMs) const;
+    void UpdatePercentiles();
+
+private:
+    std::array<FrameSample, HISTORY_SIZE> m_Samples;
+    std::array<float, HISTORY_SIZE> m_FrameTimes;
+    std::array<float, HISTORY_SIZE> m_Scratch; // sorted copy for percentiles
+    std::array<float, HISTOGRAM_BUCKETS> m_Histogram;
+    uint32_t m_Head;
+    uint32_t m_Count;
+    uint64_t m_FrameIndex;
+    float m_FrameTimeSum;
+
+    float m_P50;
+    float m_P95;
+    float m_P99;
+
+    float m_HitchBudgetMs;
+    uint32_t m_HitchCount;
+
+    std::chrono::steady_clock::time_point m_FrameStart;
+
+    static uint32_t s_DrawCalls;
+    static uint32_t s_Triangles;
+    static uint32_t s_UniformUploads;
+};
+
+#endif
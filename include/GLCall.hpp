@@ -0,0 +1,114 @@
+#ifndef GL_CALL_HPP
+#define GL_CALL_HPP
+
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl3.h>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+// Debug builds count and validate every wrapped call, Release builds call GL directly.
+// Either can be forced with -DGL_CALL_COUNTING=0/1 and -DGL_CALL_CHECKING=0/1 (premake5 --gl-stats)
+#ifndef GL_CALL_COUNTING
+#ifdef NDEBUG
+#define GL_CALL_COUNTING 0
+#else
+#define GL_CALL_COUNTING 1
+#endif
+#endif
+
+#ifndef GL_CALL_CHECKING
+#ifdef NDEBUG
+#define GL_CALL_CHECKING 0
+#else
+#define GL_CALL_CHECKING 1
+#endif
+#endif
+
+enum class GLCallCategory : uint8_t
+{
+    Draw = 0,    // glDraw*, glClear
+    State,       // glEnable, glDepthFunc, glViewport, ...
+    Bind,        // glBind*, glUseProgram, glActiveTexture
+    Buffer,      // buffer objects, vertex arrays, sync objects
+    Texture,     // texture creation and upload
+    Shader,      // compile / link / program queries
+    Uniform,     // glUniform*
+    Query,       // query objects
+    Framebuffer, // framebuffer objects
+    Other,       // glGet*, glFinish, ...
+    Count
+};
+
+const char *GLCallCategoryName(GLCallCategory category);
+
+/**
+ * Per-category GL call counters
+ *      current frame  => incremented by GL_CALL
+ *      last frame     => snapshot taken by EndFrame, shown in ImGuiOverlay
+ *      totals         => since ResetTotals, used for benchmark averages
+ */
+class GLCallStats
+{
+public:
+    using Counters = std::array<uint64_t, static_cast<std::size_t>(GLCallCategory::Count)>;
+
+    static inline void Count(GLCallCategory category) { s_Current[static_cast<std::size_t>(category)]++; }
+
+    static void EndFrame();
+    static void ResetTotals();
+
+    static const Counters &GetLastFrame() { return s_LastFrame; }
+    static const Counters &GetTotals() { return s_Totals; }
+    static uint64_t GetTotalFrames() { return s_TotalFrames; }
+    static constexpr bool IsEnabled() { return GL_CALL_COUNTING != 0; }
+
+private:
+    static Counters s_Current;
+    static Counters s_LastFrame;
+    static Counters s_Totals;
+    static uint64_t s_TotalFrames;
+};
+
+namespace GLDebug
+{
+    // KHR_debug message callback when the context has it (GL 4.3+, never on macOS),
+    // returns false when per-call glGetError checks are used instead
+    bool EnableDebugOutput();
+
+    // logs and drains every pending glGetError, no-op when debug output is active
+    void CheckErrors(const char *call, const char *file, int line);
+
+    template <typename Func>
+    inline auto Invoke(GLCallCategory category, Func &&func, const char *call, const char *file, int line)
+    {
+#if GL_CALL_COUNTING
+        GLCallStats::Count(category);
+#endif
+        if constexpr (std::is_void_v<decltype(func())>)
+        {
+            func();
+#if GL_CALL_CHECKING
+            CheckErrors(call, file, line);
+#endif
+        }
+        else
+        {
+            auto result = func();
+#if GL_CALL_CHECKING
+            CheckErrors(call, file, line);
+#endif
+            return result;
+        }
+    }
+}
+
+// GL_CALL(Draw, glDrawArrays(GL_TRIANGLES, 0, 3));
+#if GL_CALL_COUNTING || GL_CALL_CHECKING
+#define GL_CALL(category, ...) \
+    GLDebug::Invoke(GLCallCategory::category, [&]() { return __VA_ARGS__; }, #__VA_ARGS__, __FILE__, __LINE__)
+#else
+#define GL_CALL(category, ...) (__VA_ARGS__)
+#endif
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef GPU_PROFILER_HPP
+#define GPU_PROFILER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "QueryRing.hpp"
+
+struct GpuPassStats
+{
+    float lastMs;
+    float averageMs;
+    float minMs;
+    float maxMs;
+};
+
+/**
+ * Per-pass GPU timings from GL_TIME_ELAPSED queries
+ *      BeginPass/EndPass => wrap the GL calls of one render pass (passes cannot nest)
+ *      EndFrame          => collects finished queries, results lag the CPU by a few frames
+ * Passes are registered the first time their name is seen and keep a fixed-size history
+ */
+class GpuProfiler
+{
+public:
+    GpuProfiler(uint32_t latency = 4, uint32_t historySize = 240);
+    ~GpuProfiler() = default;
+
+    void BeginPass(const char *name);
+    void EndPass();
+    void EndFrame();
+
+    inline std::size_t GetPassCount() const { return m_Passes.size(); }
+    inline const std::string &GetPassName(std::size_t pass) const { return m_Passes[pass].name; }
+    GpuPassStats GetPassStats(std::size_t pass) const;
+
+    // sum of the newest result of every pass
+    float GetLastFrameMs() const;
+
+    // ring buffer of milliseconds, oldest sample at GetHistoryOffset()
+    inline const std::vector<float> &GetPassHistory(std::size_t pass) const { return m_Passes[pass].history; }
+    inline uint32_t GetHistoryOffset() const { return m_HistoryHead; }
+
+    // summary plus per-frame samples as CSV, returns false if the file can't be opened
+    bool DumpToFile(const std::string &path) const;
+
+private:
+    struct Pass
+    {
+        std::string name;
+        std::unique_ptr<QueryRing> timer;
+        std::vector<float> history;
+    };
+
+private:
+    uint32_t m_Latency;
+    uint32_t m_HistorySize;
+    uint32_t m_HistoryHead;  // next sample to overwrite
+    uint32_t m_HistoryCount; // valid samples, saturates at m_HistorySize
+
+    std::vector<Pass> m_Passes;
+    int m_ActivePass;
+};
+
+// times the enclosing scope as one GPU pass
+class GpuPassScope
+{
+public:
+    GpuPassScope(GpuProfiler &profiler, const char *name) : m_Profiler(profiler) { m_Profiler.BeginPass(name); }
+    ~GpuPassScope() { m_Profiler.EndPass(); }
+
+    GpuPassScope(const GpuPassScope &) = delete;
+    GpuPassScope &operator=(const GpuPassScope &) = delete;
+
+private:
+    GpuProfiler &m_Profiler;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <bitset>
+#include "events/Event.hpp"
+
+/**
+ * Keyboard / mouse state snapshot, rebuilt once per frame from the queued events
+ *      BeginFrame => per-frame edges and deltas reset
+ *      OnEvent    => fed every dispatched event before the layers see it, edges are recorded here
+ *                    so a press and release within one frame still register both
+ * Queries are bit tests, nothing calls back into GLFW.
+ */
+class Input
+{
+public:
+    Input();
+
+    void BeginFrame();
+    void OnEvent(const Event &event);
+
+    inline bool IsKeyDown(int key) const { return IsValidKey(key) && m_Keys.test(key); }
+    // went down / up at some point this frame, regardless of the current state
+    inline bool WasKeyPressed(int key) const { return IsValidKey(key) && m_PressedKeys.test(key); }
+    inline bool WasKeyReleased(int key) const { return IsValidKey(key) && m_ReleasedKeys.test(key); }
+
+    inline bool IsMouseButtonDown(int button) const { return IsValidButton(button) && m_Buttons.test(button); }
+
+    inline const glm::vec2 &GetMousePosition() const { return m_MousePosition; }
+    inline glm::vec2 GetMouseDelta() const { return m_HasMousePosition ? m_MousePosition - m_PreviousMousePosition : glm::vec2(0.0f); }
+    inline const glm::vec2 &GetScrollDelta() const { return m_ScrollDelta; }
+
+    inline bool AnyKeyDown() const { return m_Keys.any(); }
+
+private:
+    static constexpr bool IsValidKey(int key) { return key >= 0 && key <= GLFW_KEY_LAST; }
+    static constexpr bool IsValidButton(int button) { return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST; }
+
+private:
+    std::bitset<GLFW_KEY_LAST + 1> m_Keys;
+    std::bitset<GLFW_KEY_LAST + 1> m_PressedKeys;
+    std::bitset<GLFW_KEY_LAST + 1> m_ReleasedKeys;
+    std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> m_Buttons;
+
+    glm::vec2 m_MousePosition;
+    glm::vec2 m_PreviousMousePosition;
+    glm::vec2 m_ScrollDelta;
+    bool m_HasMousePosition; // no delta until the first move, avoids a jump from (0, 0)
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef INPUT_RECORDING_HPP
+#define INPUT_RECORDING_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "events/EventQueue.hpp"
+
+/**
+ * Input recording file (native endianness)
+ *      magic "INPREC01"
+ *      per frame => float32 delta time, uint16 event count, events
+ *      event     => uint8 QueuedEvent index, then the event's fields (int32 codes / float32 positions)
+ * Only keyboard and mouse events are stored, the window's own events always come from the live window.
+ */
+class InputRecorder
+{
+public:
+    explicit InputRecorder(const std::string &path);
+    ~InputRecorder();
+
+    // the events about to be dispatched this frame and the frame's delta time
+    void RecordFrame(const std::vector<QueuedEvent> &events, float deltaTime);
+
+    inline uint32_t GetFrameCount() const { return m_FrameCount; }
+
+    // --record-input [path], nullptr when not on the command line
+    static std::unique_ptr<InputRecorder> FromCommandLine(int argc, char **argv);
+
+private:
+    std::ofstream m_File;
+    std::string m_Path;
+    uint32_t m_FrameCount;
+};
+
+/**
+ * Plays a recording back frame by frame, replacing live keyboard/mouse input and the frame's
+ * update delta time, so layers and the camera see exactly the recorded sequence
+ */
+class InputReplay
+{
+public:
+    explicit InputReplay(const std::string &path);
+
+    // swaps this frame's live input in 'queue' for the recorded events, false once the recording ran out
+    bool NextFrame(EventQueue &queue, float &deltaTime);
+
+    inline uint32_t GetFrameIndex() const { return m_FrameIndex; }
+    inline uint32_t GetFrameCount() const { return m_FrameCount; }
+
+    // --replay-input [path], nullptr when not on the command line
+    static std::unique_ptr<InputReplay> FromCommandLine(int argc, char **argv);
+
+private:
+    std::vector<unsigned char> m_Data;
+    std::size_t m_Offset;
+    uint32_t m_FrameIndex;
+    uint32_t m_FrameCount;
+};
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// completion count for a group of jobs, JobSystem::Wait helps run jobs until it drops to zero
+class JobCounter
+{
+public:
+    JobCounter() : m_Pending(0) {}
+
+    JobCounter(const JobCounter &) = delete;
+    JobCounter &operator=(const JobCounter &) = delete;
+
+    inline bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32_t> m_Pending;
+};
+
+using JobFunction = void (*)(void *data, uint32_t begin, uint32_t end);
+
+/**
+ * One unit of work, plain data so queueing never allocates
+ * 'data' must stay alive until the job's counter is done.
+ */
+struct Job
+{
+    JobFunction function;
+    void *data;
+    uint32_t begin;
+    uint32_t end;
+    JobCounter *counter;
+    const char *name; // trace label, not copied
+};
+
+// per-thread share of the last frame, for the profiler overlay
+struct JobThreadStats
+{
+    float utilization; // busy time / frame time, 0..1
+    uint32_t jobs;     // jobs run last frame
+    uint32_t steals;   // of those, taken from another thread's queue
+};
+
+/**
+ * Work-stealing job system, owned by Application
+ *      - every worker has its own fixed-size deque: it pushes and pops at the back (LIFO, cache warm),
+ *        idle threads steal from the front of the others' deques (FIFO, oldest and largest work first)
+ *      - queue 0 belongs to the threads that are not workers (the main thread), a thread waiting
+ *        on a counter runs queued jobs instead of blocking
+ *      - ParallelFor splits [0, count) into grainSize chunks, ranges at or below one grain run inline
+ *      - long work (file loads, decoding) goes through SubmitBackground onto a shared low priority
+ *        queue that only idle workers take from; a waiting thread never picks it up, so a per-frame
+ *        Wait cannot end up running a whole decode
+ *      - jobs are plain function pointer + data, submitting never touches the heap
+ * With 0 workers everything runs inline on the calling thread.
+ */
+class JobSystem
+{
+public:
+    static constexpr uint32_t QUEUE_CAPACITY = 1024;
+    static constexpr uint32_t MAX_WORKERS = 64;
+
+    // workerCount 0 => run everything on the calling thread, < 0 => one worker per spare core,
+    // capped at MAX_WORKERS
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    // queues a job on the calling thread's deque (runs it inline if the deque is full)
+    void Submit(JobFunction function, void *data, JobCounter &counter, const char *name = "Job",
+                uint32_t begin = 0, uint32_t end = 1);
+
+    // queues long-running work for the workers only (runs it inline if there are none)
+    void SubmitBackground(JobFunction function, void *data, JobCounter &counter, const char *name = "BackgroundJob");
+
+    // runs queued frame jobs (never background ones) until 'counter' is done
+    void Wait(JobCounter &counter);
+
+    // function(begin, end) over [0, count) in chunks of grainSize, returns when all chunks ran
+    template <typename F>
+    void ParallelFor(uint32_t count, uint32_t grainSize, F &&function, const char *name = "ParallelFor")
+    {
+        grainSize = grainSize > 0 ? grainSize : 1;
+        if (m_Workers.empty() || count <= grainSize)
+        {
+            if (count > 0)
+                function(0u, count);
+            return;
+        }
+
+        using Function = std::remove_reference_t<F>;
+        JobFunction trampoline = [](void *data, uint32_t begin, uint32_t end)
+        { (*static_cast<Function *>(data))(begin, end); };
+
+        JobCounter counter;
+        SubmitRange(trampoline, const_cast<void *>(static_cast<const void *>(&function)), count, grainSize, counter, name);
+        Wait(counter);
+    }
+
+    // snapshots the per-thread stats, called once per frame
+    void EndFrame();
+
+    // workers plus the main thread
+    inline uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Workers.size()) + 1; }
+    inline uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+    // index 0 is the main thread (jobs it ran while waiting)
+    inline const std::vector<JobThreadStats> &GetThreadStats() const { return m_ThreadStats; }
+
+    // --job-workers N, default one worker per spare core
+    static std::unique_ptr<JobSystem> FromCommandLine(int argc, char **argv);
+
+private:
+    // mutex-guarded ring, contention is rare since owners and thieves work at opposite ends
+    struct JobQueue
+    {
+        std::mutex mutex;
+        Job jobs[QUEUE_CAPACITY];
+        uint32_t head = 0; // steal end
+        uint32_t tail = 0; // owner end
+
+        bool Push(const Job &job);
+        bool Pop(Job &job);
+        bool Steal(Job &job);
+    };
+
+    struct ThreadCounters
+    {
+        std::atomic<uint64_t> busyNs{0};
+        std::atomic<uint32_t> jobs{0};
+        std::atomic<uint32_t> steals{0};
+    };
+
+    void SubmitRange(JobFunction function, void *data, uint32_t count, uint32_t grainSize, JobCounter &counter,
+                     const char *name);
+    void WorkerLoop(uint32_t index);
+    // own queue first, then steals, then (idle workers only) the background queue;
+    // returns false when there was nothing to run
+    bool RunOne(uint32_t index, bool allowBackground);
+    void Execute(const Job &job, uint32_t index);
+    void WakeWorkers(uint32_t jobCount);
+
+private:
+    std::vector<std::unique_ptr<JobQueue>> m_Queues;         // one per thread, 0 = main
+    std::vector<std::unique_ptr<ThreadCounters>> m_Counters; // one per thread, 0 = main
+    std::unique_ptr<JobQueue> m_BackgroundQueue;            // shared, FIFO, workers only
+    std::vector<std::thread> m_Workers;
+    std::vector<std::string> m_ThreadNames; // the profiler keeps the pointers
+
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCondition;
+    std::atomic<int32_t> m_QueuedJobs; // may dip below zero while a push is being published
+    std::atomic<bool> m_Running;
+
+    std::vector<JobThreadStats> m_ThreadStats;
+    std::vector<uint64_t> m_LastBusyNs;
+    uint64_t m_LastFrameNs;
+};
+
+#endif
@@ -2,7 +2,16 @@
 #define LAYER_HPP
 
 #include <string>
-#include "events/Event.hpp"
+#include "events/EventTable.hpp"
+
+// measured by LayerStack around OnUpdate / OnRender, the averages are smoothed over recent frames
+struct LayerTiming
+{
+    float updateMs = 0.0f;
+    float renderMs = 0.0f;
+    float averageUpdateMs = 0.0f;
+    float averageRenderMs = 0.0f;
+};
 
 class Layer
 {
@@ -20,15 +29,24 @@ public:
 
     virtual void OnUpdate(float deltaTime) {}
     virtual void OnRender() {}
-    virtual void OnEvent(Event &event) {}
+
+    // register handlers for the event types this layer cares about, called by LayerStack
+    // whenever the stack changes (after OnAttach), layers that subscribe to nothing never see events
+    virtual void SubscribeEvents(EventTable &events) {}
 
     const inline std::string &GetName() const { return m_DebugName; }
-    inline void SetVisibility(bool visible) { m_Visible = visible; }
+    // hidden layers are skipped by the frame loop, change it through LayerStack::SetVisibility
     inline bool IsVisible() const { return m_Visible; }
+    inline const LayerTiming &GetTiming() const { return m_Timing; }
 
 protected:
     std::string m_DebugName;
     bool m_Visible; // visibility flag (for ImGUI layer management)
+
+private:
+    friend class LayerStack;
+    LayerTiming m_Timing;
+    const char *m_ProfileName = nullptr; // interned copy of m_DebugName, trace events outlive the layer
 };
 
 #endif
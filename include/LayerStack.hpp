@@ -2,32 +2,60 @@
 #define LAYER_STACK_HPP
 
 #include "Layer.hpp"
+#include "events/EventTable.hpp"
+#include <memory>
 #include <vector>
 #include <algorithm>
 
+/**
+ * Owns the layers, bottom to top: regular layers first, overlays after them
+ * Visible layers are kept in a separate list so the per-frame loops never look at hidden ones.
+ * Visibility changes are applied at the start of the next UpdateLayers, which makes it safe to
+ * toggle a layer from inside another layer's OnUpdate/OnRender (the ImGui layer panel does).
+ */
 class LayerStack
 {
 public:
+    using LayerList = std::vector<std::unique_ptr<Layer>>;
+
     LayerStack() = default;
     ~LayerStack();
 
-    void PushLayer(Layer *layer);
-    void PopLayer(Layer *layer);
+    // takes ownership and attaches, returns the layer for convenience
+    Layer *PushLayer(std::unique_ptr<Layer> layer);
+    Layer *PushOverlay(std::unique_ptr<Layer> overlay);
+
+    // detaches and hands ownership back, nullptr when the layer is not in the stack
+    std::unique_ptr<Layer> PopLayer(Layer *layer);
+    std::unique_ptr<Layer> PopOverlay(Layer *overlay);
+
+    void SetVisibility(Layer *layer, bool visible);
 
-    void PushOverlay(Layer *overlay);
-    void PopOverlay(Layer *overlay);
+    // active layers only, bottom to top, each one timed into its LayerTiming
+    void UpdateLayers(float deltaTime);
+    void RenderLayers();
 
-    std::vector<Layer *>::iterator begin() { return m_Layers.begin(); }
-    std::vector<Layer *>::iterator end() { return m_Layers.end(); }
+    LayerList::iterator begin() { return m_Layers.begin(); }
+    LayerList::iterator end() { return m_Layers.end(); }
 
-    std::vector<Layer *>::const_iterator begin() const { return m_Layers.begin(); }
-    std::vector<Layer *>::const_iterator end() const { return m_Layers.end(); }
+    LayerList::const_iterator begin() const { return m_Layers.begin(); }
+    LayerList::const_iterator end() const { return m_Layers.end(); }
 
     Layer *FindLayerByName(const std::string &name) const;
 
+    inline const std::vector<Layer *> &GetActiveLayers() const { return m_ActiveLayers; }
+    inline const EventTable &GetEventTable() const { return m_EventTable; }
+
+private:
+    void RebuildEventTable();
+    void RebuildActiveLayers();
+
 private:
-    std::vector<Layer *> m_Layers;
+    LayerList m_Layers;
     unsigned int m_LayerInsertIndex = 0;
+    std::vector<Layer *> m_ActiveLayers; // visible subset of m_Layers, same order
+    bool m_ActiveLayersDirty = false;
+    EventTable m_EventTable;
 };
 
 #endif
@@ -0,0 +1,107 @@
+#ifndef LIGHT_GRID_HPP
+#define LIGHT_GRID_HPP
+
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl3.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "FrameArena.hpp"
+#include "JobSystem.hpp"
+
+struct PointLight
+{
+    glm::vec3 position;
+    float radius; // no contribution beyond this distance
+    glm::vec3 color;
+    float intensity;
+};
+
+/**
+ * Screen space / clustered light binning
+ * The view frustum is split into tileSize x tileSize pixel tiles and depthSlices exponential
+ * view depth slices (froxels). Every light is added to the clusters covered by its projected
+ * bounding rectangle and view depth range. With a single slice this is plain 2D tiling.
+ * Results are uploaded to buffer textures:
+ *      lightData     (samplerBuffer,  RGBA32F) => 2 texels per light: (position, radius), (color, intensity)
+ *      clusterRanges (usamplerBuffer, RG32UI)  => per cluster (offset, count) into lightIndices
+ *      lightIndices  (usamplerBuffer, R32UI)   => light indices, grouped by cluster
+ *
+ * Cluster index = (slice * tileCountY + tileY) * tileCountX + tileX
+ * Slice         = floor(log(viewDepth) * sliceScale + sliceBias)
+ *
+ * Lights are culled in parallel chunks, then depth slices are assigned by jobs that each own a
+ * contiguous run of slices
+ */
+class LightGrid
+{
+public:
+    LightGrid(uint32_t tileSize = 32, uint32_t depthSlices = 1);
+    ~LightGrid();
+
+    LightGrid(const LightGrid &) = delete;
+    LightGrid &operator=(const LightGrid &) = delete;
+
+    // near/far planes of the projection passed to Build, only matters with more than one slice
+    void SetDepthRange(float nearPlane, float farPlane);
+
+    // per-build scratch (visible lights, per-job lists) comes from the frame arena
+    void Build(const PointLight *lights, std::size_t lightCount, const glm::mat4 &view, const glm::mat4 &projection,
+               int width, int height, FrameArena &arena, JobSystem &jobs);
+
+    // binds the three buffer textures to consecutive texture units
+    void BindTextures(GLenum firstUnit) const;
+
+    inline uint32_t GetTileSize() const { return m_TileSize; }
+    inline uint32_t GetTileCountX() const { return m_TileCountX; }
+    inline uint32_t GetTileCountY() const { return m_TileCountY; }
+    inline uint32_t GetDepthSlices() const { return m_DepthSlices; }
+    inline float GetSliceScale() const { return m_SliceScale; }
+    inline float GetSliceBias() const { return m_SliceBias; }
+    inline std::size_t GetLightCount() const { return m_LightData.size() / 2; }
+    inline std::size_t GetIndexCount() const { return m_LightIndices.size(); }
+    inline uint32_t GetWorkerCount() const { return m_WorkerCount; }
+
+private:
+    struct ClusterBounds
+    {
+        glm::ivec4 tiles; // min x, min y, max x, max y
+        int firstSlice;
+        int lastSlice;
+    };
+
+    // clusters covered by a light, returns false when the light is outside the frustum
+    bool GetClusterBounds(const PointLight &light, const glm::mat4 &view, const glm::mat4 &projection,
+                          ClusterBounds &bounds) const;
+    int GetSlice(float viewDepth) const;
+
+    // counts, prefix sums and scatters slices [firstSlice, lastSlice), touches only their clusters
+    void AssignSlices(const FrameVector<ClusterBounds> &lightBounds, uint32_t firstSlice, uint32_t lastSlice,
+                      FrameVector<uint32_t> &indices);
+    void Upload();
+
+private:
+    uint32_t m_TileSize;
+    uint32_t m_DepthSlices;
+    uint32_t m_TileCountX;
+    uint32_t m_TileCountY;
+    int m_Width;
+    int m_Height;
+
+    float m_NearPlane;
+    float m_FarPlane;
+    float m_SliceScale;
+    float m_SliceBias;
+
+    // CPU side, reused every frame
+    std::vector<glm::vec4> m_LightData;
+    std::vector<uint32_t> m_ClusterRanges;
+    std::vector<uint32_t> m_LightIndices;
+
+    uint32_t m_WorkerCount; // slice jobs used by the last build
+
+    GLuint m_Buffers[3];
+    GLuint m_Textures[3];
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef LOG_QUEUE_HPP
+#define LOG_QUEUE_HPP
+
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// one already formatted message, fixed size so pushing never touches the heap
+struct LogRecord
+{
+    static constexpr std::size_t TEXT_CAPACITY = 232; // longer messages are truncated with "..."
+
+    spdlog::log_clock::time_point time;
+    spdlog::level::level_enum level;
+    uint32_t length;
+    char text[TEXT_CAPACITY];
+};
+
+/**
+ * Bounded lock-free MPSC ring of LogRecords (per-slot sequence numbers, Vyukov style)
+ *      TryPush => any thread, fails instead of waiting when the ring is full
+ *      TryPop  => the Logger's writer thread only
+ */
+class LogQueue
+{
+public:
+    // capacity is rounded up to a power of two
+    explicit LogQueue(std::size_t capacity);
+
+    LogQueue(const LogQueue &) = delete;
+    LogQueue &operator=(const LogQueue &) = delete;
+
+    bool TryPush(spdlog::level::level_enum level, spdlog::log_clock::time_point time, const char *text,
+                 std::size_t length);
+    bool TryPop(LogRecord &record);
+
+    inline std::size_t GetCapacity() const { return m_Mask + 1; }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    std::unique_ptr<Slot[]> m_Slots;
+    std::size_t m_Mask;
+    alignas(64) std::atomic<std::size_t> m_EnqueuePos;
+    alignas(64) std::size_t m_DequeuePos; // single consumer, no atomics needed
+};
+
+#endif
@@ -3,96 +3,157 @@
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include "AllocationTracker.hpp"
+#include "LogQueue.hpp"
+
+// levels below this are compiled out entirely (SPDLOG_LEVEL_* values, premake sets INFO for Release)
+#ifndef LOG_ACTIVE_LEVEL
+#define LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+// what a producer does when the async ring is full, Warn and above always block
+enum class LogOverflowPolicy
+{
+    Drop,
+    Block
+};
 
+/**
+ * Synchronous until StartAsync is called, after that messages are formatted into a fixed-size
+ * record on the calling thread and pushed to a lock-free ring, a writer thread does the console I/O.
+ * Critical drains the ring and writes synchronously so it is visible before the throw that follows it.
+ */
 class Logger
 {
 private:
     std::shared_ptr<spdlog::logger> m_Logger;
 
+    std::unique_ptr<LogQueue> m_Queue;
+    std::atomic<bool> m_Async;
+    std::atomic<bool> m_Running;
+    std::atomic<uint64_t> m_Pending; // pushed but not yet written
+    std::atomic<uint64_t> m_Dropped;
+    LogOverflowPolicy m_Policy;
+
+    std::thread m_Writer;
+    std::mutex m_WakeMutex;
+    std::condition_variable m_Wake;
+
 public:
-    // static wrappers for logging with formatting support
+    static void StartAsync(LogOverflowPolicy policy = LogOverflowPolicy::Drop, std::size_t capacity = 4096);
+    // drains everything still queued and joins the writer
+    static void StopAsync();
+    // blocks until the writer has caught up
+    static void Flush();
+
+    static bool IsAsync() { return Instance().m_Async.load(std::memory_order_relaxed); }
+    static uint64_t GetDroppedCount() { return Instance().m_Dropped.load(std::memory_order_relaxed); }
+
+    // static wrappers for logging with formatting support, the format string is checked against the
+    // arguments at compile time. Below LOG_ACTIVE_LEVEL the body is empty but the call site still
+    // evaluates its arguments, prefer the LOG_* macros for anything that costs something to build
     template <typename... Args>
-    static void Trace(const std::string &format, Args &&...args)
+    static void Trace(fmt::format_string<Args...> format, Args &&...args)
     {
-        Instance().TraceImpl(format, std::forward<Args>(args)...);
+        if constexpr (LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE)
+            Instance().Log(spdlog::level::trace, format, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    static void Debug(const std::string &format, Args &&...args)
+    static void Debug(fmt::format_string<Args...> format, Args &&...args)
     {
-        Instance().DebugImpl(format, std::forward<Args>(args)...);
+        if constexpr (LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG)
+            Instance().Log(spdlog::level::debug, format, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    static void Info(const std::string &format, Args &&...args)
+    static void Info(fmt::format_string<Args...> format, Args &&...args)
     {
-        Instance().InfoImpl(format, std::forward<Args>(args)...);
+        if constexpr (LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO)
+            Instance().Log(spdlog::level::info, format, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    static void Warn(const std::string &format, Args &&...args)
+    static void Warn(fmt::format_string<Args...> format, Args &&...args)
     {
-        Instance().WarnImpl(format, std::forward<Args>(args)...);
+        if constexpr (LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN)
+            Instance().Log(spdlog::level::warn, format, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    static void Error(const std::string &format, Args &&...args)
+    static void Error(fmt::format_string<Args...> format, Args &&...args)
     {
-        Instance().ErrorImpl(format, std::forward<Args>(args)...);
+        if constexpr (LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR)
+            Instance().Log(spdlog::level::err, format, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    static void Critical(const std::string &format, Args &&...args)
+    static void Critical(fmt::format_string<Args...> format, Args &&...args)
     {
-        Instance().CriticalImpl(format, std::forward<Args>(args)...);
+        if constexpr (LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL)
+            Instance().Log(spdlog::level::critical, format, std::forward<Args>(args)...);
     }
 
 private:
     // Singleton instance accessor
     static Logger &Instance();
 
-    // Actual implementations for logging
-    template <typename... Args>
-    void TraceImpl(const std::string &format, Args &&...args)
-    {
-        m_Logger->trace(format, std::forward<Args>(args)...);
-    }
-
     template <typename... Args>
-    void DebugImpl(const std::string &format, Args &&...args)
+    void Log(spdlog::level::level_enum level, fmt::format_string<Args...> format, Args &&...args)
     {
-        m_Logger->debug(format, std::forward<Args>(args)...);
+        AllocationScope allocationScope(AllocTag::Logging);
+        if (!m_Async.load(std::memory_order_acquire) || level >= spdlog::level::critical)
+        {
+            if (level >= spdlog::level::critical)
+                Flush();
+            m_Logger->log(level, format, std::forward<Args>(args)...);
+            return;
+        }
+
+        // format on the caller into a stack buffer, the writer only copies bytes to the sink
+        char buffer[LogRecord::TEXT_CAPACITY + 1];
+        auto result = fmt::format_to_n(buffer, sizeof(buffer), format, std::forward<Args>(args)...);
+        Enqueue(level, buffer, static_cast<std::size_t>(result.size));
     }
 
-    template <typename... Args>
-    void InfoImpl(const std::string &format, Args &&...args)
-    {
-        m_Logger->info(format, std::forward<Args>(args)...);
-    }
-
-    template <typename... Args>
-    void WarnImpl(const std::string &format, Args &&...args)
-    {
-        m_Logger->warn(format, std::forward<Args>(args)...);
-    }
-
-    template <typename... Args>
-    void ErrorImpl(const std::string &format, Args &&...args)
-    {
-        m_Logger->error(format, std::forward<Args>(args)...);
-    }
-
-    template <typename... Args>
-    void CriticalImpl(const std::string &format, Args &&...args)
-    {
-        m_Logger->critical(format, std::forward<Args>(args)...);
-    }
+    void StopWriter();
+    void Enqueue(spdlog::level::level_enum level, const char *text, std::size_t length);
+    void WriterLoop();
+    void Write(const LogRecord &record);
 
     Logger();
+    ~Logger();
 
     Logger(const Logger &) = delete;
     Logger &operator=(const Logger &) = delete;
 };
 
+/**
+ * LOG_DEBUG("bodies {}", CountBodies())
+ * Below LOG_ACTIVE_LEVEL the whole statement is dropped by the preprocessor, like LOG_BINARY,
+ * so neither the format string nor the argument expressions are evaluated
+ */
+#if LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define LOG_TRACE(...) Logger::Trace(__VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#if LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::Debug(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::Info(__VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
 #endif
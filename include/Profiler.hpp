@@ -0,0 +1,103 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// build with -DPROFILING_ENABLED=0 to compile every PROFILE_* macro away
+#ifndef PROFILING_ENABLED
+#define PROFILING_ENABLED 1
+#endif
+
+/**
+ * One completed CPU scope
+ * name/detail are not copied, they must live until the process exits
+ * (string literals, or Profiler::Intern for names built at runtime)
+ */
+struct TraceEvent
+{
+    const char *name;
+    const char *detail; // optional, shown as "detail name"
+    uint64_t startNs;
+    uint64_t durationNs;
+};
+
+/**
+ * CPU scope profiler with Chrome trace export (chrome://tracing, ui.perfetto.dev)
+ * Every thread records into its own fixed-size ring, so recording is lock-free
+ * (a mutex is only taken the first time a thread records).
+ * The newest TRACE_BUFFER_CAPACITY events of each thread are kept, older ones are overwritten.
+ */
+class Profiler
+{
+public:
+    static constexpr uint32_t TRACE_BUFFER_CAPACITY = 1 << 16;
+
+    static void Record(const char *name, const char *detail, uint64_t startNs, uint64_t endNs);
+
+    // label for the calling thread in the trace viewer, copied
+    static void SetThreadName(const char *name);
+
+    // copy that is never freed, the same text always returns the same pointer
+    // meant for names created once (layers, threads), not for per-frame strings
+    static const char *Intern(const std::string &text);
+
+    static void SetEnabled(bool enabled) { s_Enabled.store(enabled, std::memory_order_relaxed); }
+    static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+    // nanoseconds since the profiler was first used
+    static uint64_t Now();
+
+    // snapshot of every thread's ring as Chrome trace JSON, safe while other threads keep recording
+    static bool WriteChromeTrace(const std::string &path);
+
+    // per-thread event ring, defined in Profiler.cpp
+    struct ThreadBuffer;
+
+private:
+    static ThreadBuffer &GetThreadBuffer();
+
+    static std::atomic<bool> s_Enabled;
+};
+
+// times the enclosing scope, prefer the PROFILE_* macros
+class ProfileScope
+{
+public:
+    ProfileScope(const char *name, const char *detail = nullptr)
+        : m_Name(name), m_Detail(detail), m_Start(Profiler::IsEnabled() ? Profiler::Now() : 0)
+    {
+    }
+
+    ~ProfileScope()
+    {
+        if (m_Start)
+            Profiler::Record(m_Name, m_Detail, m_Start, Profiler::Now());
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    const char *m_Name;
+    const char *m_Detail;
+    uint64_t m_Start;
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if PROFILING_ENABLED
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_SCOPE_DETAIL(name, detail) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name, detail)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__PRETTY_FUNCTION__)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_SCOPE_DETAIL(name, detail)
+#define PROFILE_FUNCTION()
+#endif
+
+#endif
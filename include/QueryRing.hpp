@@ -0,0 +1,48 @@
+#ifndef QUERY_RING_HPP
+#define QUERY_RING_HPP
+
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl3.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Ring of GL query objects for one measurement repeated every frame
+ * (GL_SAMPLES_PASSED, GL_TIME_ELAPSED, ...)
+ * Results are read back a few frames later once the GPU reports them available,
+ * so Poll never stalls the pipeline. If every query is still in flight, Begin skips
+ * the frame instead of waiting.
+ */
+class QueryRing
+{
+public:
+    QueryRing(GLenum target, uint32_t size = 4);
+    ~QueryRing();
+
+    QueryRing(const QueryRing &) = delete;
+    QueryRing &operator=(const QueryRing &) = delete;
+
+    void Begin();
+    void End();
+
+    // collects every finished query, returns true if a new result arrived
+    bool Poll();
+
+    inline GLuint64 GetLastResult() const { return m_LastResult; }
+    inline bool HasResult() const { return m_HasResult; }
+    inline uint32_t GetSkippedCount() const { return m_Skipped; }
+
+private:
+    GLenum m_Target;
+    std::vector<GLuint> m_Queries;
+    uint32_t m_WriteIndex; // next query to begin
+    uint32_t m_ReadIndex;  // oldest query in flight
+    uint32_t m_Pending;
+    bool m_Active;
+
+    GLuint64 m_LastResult;
+    bool m_HasResult;
+    uint32_t m_Skipped;
+};
+
+#endif
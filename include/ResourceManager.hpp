@@ -0,0 +1,163 @@
+#ifndef RESOURCE_MANAGER_HPP
+#define RESOURCE_MANAGER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "JobSystem.hpp"
+#include "Shader.hpp"
+#include "Texture.hpp"
+
+/**
+ * Reference to a resource slot, a plain value that is cheap to copy and store
+ * The generation changes on a slot's last Release, so a handle kept after it is detected
+ * instead of silently pointing at a cached texture or whatever reuses the slot.
+ */
+template <typename T>
+struct ResourceHandle
+{
+    uint32_t index = 0;
+    uint32_t generation = 0; // 0 is never handed out
+
+    inline bool IsValid() const { return generation != 0; }
+    inline bool operator==(const ResourceHandle &other) const { return index == other.index && generation == other.generation; }
+    inline bool operator!=(const ResourceHandle &other) const { return !(*this == other); }
+};
+
+using TextureHandle = ResourceHandle<Texture>;
+using ShaderHandle = ResourceHandle<Shader>;
+
+enum class ResourceState : uint8_t
+{
+    Loading,  // decode job in flight
+    Decoded,  // pixels ready, waiting for its upload in Update
+    Resident, // on the GPU
+    Evicted,  // dropped to stay under the budget, reloaded the next time it is used
+    Failed
+};
+
+const char *ResourceStateName(ResourceState state);
+
+// one row of the resource overlay
+struct TextureInfo
+{
+    const std::string *path;
+    ResourceState state;
+    uint32_t references;
+    std::size_t bytes;
+    bool alias; // same file content as another path, shares its texture
+};
+
+/**
+ * Textures and shaders shared by every layer, owned by Application
+ *      - Load* returns a handle holding one reference, Release drops it; loading the same file
+ *        again (normalized path) returns the same slot with one more reference
+ *      - textures are read and decoded on the job system, Update uploads a few per frame on the
+ *        GL thread; until then Get returns a small placeholder, so callers never wait
+ *      - a texture whose file bytes hash the same as one already loaded under another path
+ *        shares that texture instead of being uploaded twice
+ *      - when resident textures exceed the VRAM budget, Update evicts the least recently used:
+ *        unreferenced ones are freed, referenced ones are reloaded the next time Get sees them.
+ *        Textures used in the last couple of frames are never evicted, the budget can be
+ *        exceeded rather than reloading every frame.
+ * Shaders are small, compiled synchronously, and stay until their last reference is released.
+ */
+class ResourceManager
+{
+public:
+    static constexpr uint32_t MAX_UPLOADS_PER_FRAME = 2;
+    static constexpr uint32_t EVICTION_GRACE_FRAMES = 2;
+
+    ResourceManager(JobSystem &jobs, std::size_t vramBudgetBytes = 1024ull * 1024 * 1024);
+    ~ResourceManager();
+
+    ResourceManager(const ResourceManager &) = delete;
+    ResourceManager &operator=(const ResourceManager &) = delete;
+
+    // paths are relative to assets/textures/ and assets/shaders/
+    TextureHandle LoadTexture(const std::string &path);
+    ShaderHandle LoadShader(const std::string &vertexPath, const std::string &fragmentPath);
+
+    void Release(TextureHandle handle);
+    void Release(ShaderHandle handle);
+
+    // placeholder while loading or evicted, nullptr for a stale handle
+    Texture *Get(TextureHandle handle);
+    // nullptr for a stale handle
+    Shader *Get(ShaderHandle handle) const;
+    ResourceState GetState(TextureHandle handle) const;
+
+    // uploads decoded textures and enforces the budget, once per frame before the layers run
+    void Update();
+
+    inline std::size_t GetVramUsed() const { return m_VramUsed; }
+    inline std::size_t GetVramBudget() const { return m_VramBudget; }
+    inline void SetVramBudget(std::size_t bytes) { m_VramBudget = bytes; }
+    inline uint32_t GetPendingCount() const { return m_Pending; }
+    inline uint32_t GetEvictionCount() const { return m_Evictions; }
+    void GetTextureInfo(std::vector<TextureInfo> &rows) const;
+
+    // --vram-budget MB
+    static std::unique_ptr<ResourceManager> FromCommandLine(JobSystem &jobs, int argc, char **argv);
+
+private:
+    struct TextureSlot
+    {
+        uint32_t generation = 1;
+        uint32_t references = 0;
+        ResourceState state = ResourceState::Loading;
+        std::string path; // normalized, empty while the slot is free
+        uint64_t contentHash = 0;
+        uint32_t aliasOf = UINT32_MAX; // slot that owns the texture when the content matched
+        uint64_t lastUsedFrame = 0;
+        std::size_t bytes = 0;
+
+        std::unique_ptr<Texture> texture;
+        TextureImage image; // written by the decode job, released after the upload
+        JobCounter decodeJob;
+    };
+
+    struct ShaderSlot
+    {
+        uint32_t generation = 1;
+        uint32_t references = 0;
+        std::string key; // "vertex|fragment", empty while the slot is free
+        std::unique_ptr<Shader> shader;
+    };
+
+    static void DecodeTextureJob(void *data, uint32_t begin, uint32_t end);
+
+    TextureSlot *Resolve(TextureHandle handle) const;
+    void QueueDecode(TextureSlot &slot);
+    void Upload(uint32_t index);
+    void Evict(uint32_t index);
+    void FreeTexture(uint32_t index);
+    void EnforceBudget();
+
+private:
+    JobSystem &m_Jobs;
+    std::string m_TexturePath;
+    std::string m_ShaderPath;
+
+    // slots are heap allocated so decode jobs keep a stable pointer while the vector grows
+    std::vector<std::unique_ptr<TextureSlot>> m_Textures;
+    std::vector<uint32_t> m_FreeTextures;
+    std::unordered_map<std::string, uint32_t> m_TexturesByPath;
+    std::unordered_map<uint64_t, uint32_t> m_TexturesByContent;
+
+    std::vector<ShaderSlot> m_Shaders;
+    std::vector<uint32_t> m_FreeShaders;
+    std::unordered_map<std::string, uint32_t> m_ShadersByKey;
+
+    std::unique_ptr<Texture> m_Placeholder;
+    std::size_t m_VramBudget;
+    std::size_t m_VramUsed;
+    uint64_t m_Frame;
+    uint32_t m_Pending;
+    uint32_t m_Evictions;
+    bool m_OverBudgetWarned;
+};
+
+#endif
@@ -59,31 +59,4 @@ private:
     GLint GetUniformLocation(const std::string &uniformName);
 };
 
-class ShaderManager
-{
-private:
-    std::unordered_map<std::string, Shader *> m_Shaders;
-    std::string m_ShaderDefaultPath;
-    std::vector<std::string> m_ShaderNames;
-
-public:
-    ShaderManager();
-    ~ShaderManager();
-
-    void AddShader(const std::string &shaderName, const std::string &vertexShaderPath, const std::string &fragmentShaderPath);
-    void UseShader(const std::string &shaderName);
-
-    // HINT: dont call this method to remove OnDetach method
-    // ShaderManager destructor method will handle deletion automatically
-    void RemoveShader(const std::string &shaderName);
-
-    void inline SetShaderDefaultPath(const std::string &defaultPath) { m_ShaderDefaultPath = defaultPath; }
-
-    Shader *GetShader(const std::string &shaderName);
-
-    const inline std::vector<std::string> &GetShaderNames() const { return m_ShaderNames; }
-
-    static std::unique_ptr<ShaderManager> Create();
-};
-
-#endif
\ No newline at end of file
+#endif
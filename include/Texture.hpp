@@ -4,10 +4,33 @@
 #define GL_SILENCE_DEPRECATION
 
 #include <string>
-#include <unordered_map>
 #include <OpenGL/gl3.h>
 #include <GLFW/glfw3.h>
 #include <vector>
+#include <memory>
+#include "JobSystem.hpp"
+
+// pixels decoded from an image file, CPU only so it can be filled on any thread
+struct TextureImage
+{
+    std::string path;
+    unsigned char *pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+
+    TextureImage() = default;
+    ~TextureImage();
+    TextureImage(const TextureImage &) = delete;
+    TextureImage &operator=(const TextureImage &) = delete;
+
+    // false (and pixels stay null) when the file could not be read
+    bool Decode(const std::string &filePath);
+    // decodes an image file already read into memory, sourcePath is only kept for messages
+    bool Decode(const unsigned char *data, std::size_t size, const std::string &sourcePath);
+    // frees the pixels, the image can be decoded into again
+    void Reset();
+};
 
 class Texture
 {
@@ -20,7 +43,11 @@ private:
 
 public:
     Texture(const std::string &path);
-    Texture(const std::vector<std::string> &cubeFaces);
+    // uploads an already decoded image, needs the GL context
+    explicit Texture(const TextureImage &image);
+    Texture(const unsigned char *pixels, int width, int height, int channels);
+    // faces are decoded on the job system when one is given
+    Texture(const std::vector<std::string> &cubeFaces, JobSystem *jobs = nullptr);
     ~Texture();
 
     void Bind(GLenum textureUnit = GL_TEXTURE0) const;
@@ -30,34 +57,9 @@ public:
     std::pair<int, int> GetDimensions() const;
 
 private:
-    void LoadFromFile(const std::string &path);
-    void LoadCubemap(const std::vector<std::string> &cubeFaces);
+    void Upload(const unsigned char *pixels, int width, int height, int channels);
+    void LoadCubemap(const std::vector<std::string> &cubeFaces, JobSystem *jobs);
     void SetDefaultParameters();
 };
 
-class TextureManager
-{
-private:
-    std::unordered_map<std::string, Texture *> m_Textures;
-    std::string m_TextureDefaultPath;
-    std::vector<std::string> m_TextureNames;
-
-public:
-    TextureManager();
-    ~TextureManager();
-
-    void AddTexture(const std::string &name, const std::string &path);
-    Texture *GetTexture(const std::string &name) const;
-    void RemoveTexture(const std::string &name);
-
-    void inline SetTextureDefaultPath(const std::string &defaultPath) { m_TextureDefaultPath = defaultPath; }
-
-    const inline std::vector<std::string> &GetTextureNames() const { return m_TextureNames; }
-
-    static std::unique_ptr<TextureManager> Create();
-
-private:
-    void ClearTextures();
-};
-
 #endif
@@ -6,7 +6,7 @@
 #include <OpenGL/gl3.h>
 #include <GLFW/glfw3.h>
 #include <string>
-#include "events/Event.hpp"
+#include "events/EventQueue.hpp"
 
 struct InitializeWindowProps
 {
@@ -23,11 +23,6 @@ struct InitializeWindowProps
 
 class Window
 {
-    // type alias that can hold any callable objects
-    // callable objects -> lambda, free function, bound memeber functions
-    // that takes a single Event& parameter and returns void
-    using EventCallbackFn = std::function<void(Event &)>;
-
 public:
     Window(const InitializeWindowProps &props = InitializeWindowProps());
     ~Window();
@@ -39,11 +34,10 @@ public:
 
     GLFWwindow *GetNativeWindow() const { return m_Window; }
 
-    // this will be bound to Application's OnEvent method
-    // props.eventCallback will point to Application::OnEvent
-    void inline SetEventCallback(const EventCallbackFn &callback)
+    // GLFW callbacks push into this queue, Application drains it once per frame
+    void inline SetEventQueue(EventQueue *queue)
     {
-        m_WindowProperties.m_EventCallback = callback;
+        m_WindowProperties.m_EventQueue = queue;
     }
 
     // Cursor modes
@@ -63,10 +57,11 @@ private:
         int m_Height;
         std::string m_Title;
         bool m_Vsync;
-        EventCallbackFn m_EventCallback;
+        EventQueue *m_EventQueue = nullptr;
     };
 
     static void GLFWErrorCallback(int error, const char *description);
+    static void PushEvent(GLFWwindow *window, const QueuedEvent &event);
 
     WindowProperties m_WindowProperties;
     GLFWwindow *m_Window;
@@ -2,6 +2,7 @@
 #define AUDIO_HPP
 
 #include "audio/OpenAL.hpp"
+#include "audio/MP3Decoder.hpp"
 #include <string>
 #include <memory>
 
@@ -14,6 +15,8 @@ public:
     // Load PCM data into OpenAL buffer
     // will use MP3Decoder in implementation
     bool LoadAudio(const std::string &audioFilePath);
+    // buffer already decoded PCM data (decoding can run on a job, this must not)
+    bool LoadPCM(const PCMData &pcmData);
 
     bool Play();
     void Stop();
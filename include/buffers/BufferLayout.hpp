@@ -44,17 +44,21 @@ struct BufferElement
     ShaderLayoutName m_ShaderLayoutName; // layout (location = index) in vec3 aPos;
     Normalized m_IsNormalized;           // are these attribute points normalized
     GLenum m_OpenGLType;
-    GLint m_Count; // number of components (count) in each attribute
+    GLint m_Count;        // number of components (count) in each attribute
+    std::size_t m_Offset; // bytes from the start of the row, filled in by BufferLayout
 
     BufferElement(BufferAttributeType attributeType, const ShaderLayoutName &name, Normalized isNormalized = false)
         : m_Type(attributeType),
           m_ShaderLayoutName(name),
           m_IsNormalized(isNormalized),
           m_OpenGLType(GetGLenumFromAttribType(attributeType)),
-          m_Count(GetCountFromType(attributeType))
+          m_Count(GetCountFromType(attributeType)),
+          m_Offset(0)
     {
     }
 
+    inline bool IsInteger() const { return m_OpenGLType != GL_FLOAT && m_OpenGLType != GL_DOUBLE; }
+
     ~BufferElement() {};
 
     static GLint GetCountFromType(BufferAttributeType type)
@@ -95,6 +99,25 @@ struct BufferElement
         }
     };
 
+    // matrices occupy one attribute location per column
+    static GLint GetColumnCountFromType(BufferAttributeType type)
+    {
+        switch (type)
+        {
+        case BufferAttributeType::iMat2:
+        case BufferAttributeType::Mat2:
+            return 2;
+        case BufferAttributeType::iMat3:
+        case BufferAttributeType::Mat3:
+            return 3;
+        case BufferAttributeType::iMat4:
+        case BufferAttributeType::Mat4:
+            return 4;
+        default:
+            return 1;
+        }
+    }
+
     static GLint GetSizeFromAttribType(BufferAttributeType type)
     {
         GLenum glEnum = GetGLenumFromAttribType(type);
@@ -190,32 +213,38 @@ struct BufferElement
 /**
  * Represent the whole vertex data
  * Stride and Offset are calculated here
- *      Stride => bytes offset between each BufferElement (whole row)
- *      Offset => offset between each attribute
+ *      Stride  => bytes offset between each BufferElement (whole row)
+ *      Offset  => bytes offset of each attribute inside the row
+ *      Divisor => 0 advances per vertex, N advances once every N instances
  */
 class BufferLayout
 {
 private:
     GLsizei m_Stride;
+    GLuint m_Divisor;
     std::vector<BufferElement> m_BufferElements;
 
 public:
     BufferLayout()
-        : m_Stride(0), m_BufferElements()
+        : m_Stride(0), m_Divisor(0), m_BufferElements()
     {
     }
 
-    BufferLayout(std::initializer_list<BufferElement> bufferElements)
-        : m_Stride(0), m_BufferElements(bufferElements)
+    BufferLayout(std::initializer_list<BufferElement> bufferElements, GLuint divisor = 0)
+        : m_Stride(0), m_Divisor(divisor), m_BufferElements(bufferElements)
     {
-        for (auto &bufferElement : bufferElements)
+        // offsets are accumulated in bytes so mixed int/float rows line up
+        for (auto &bufferElement : m_BufferElements)
         {
+            bufferElement.m_Offset = m_Stride;
             m_Stride += BufferElement::GetSizeFromAttribType(bufferElement.m_Type);
         }
-        Logger::Debug("BufferLayout Stride: {}", m_Stride);
+        LOG_DEBUG("BufferLayout Stride: {}", m_Stride);
     }
 
     inline GLsizei GetStride() const { return m_Stride; }
+    inline GLuint GetDivisor() const { return m_Divisor; }
+    inline bool IsInstanced() const { return m_Divisor != 0; }
     inline const std::vector<BufferElement> &GetBufferElements() const
     {
         return m_BufferElements;
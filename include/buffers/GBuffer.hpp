@@ -0,0 +1,50 @@
+#ifndef GBUFFER_HPP
+#define GBUFFER_HPP
+
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl3.h>
+#include <memory>
+
+/**
+ * Geometry buffer for deferred shading
+ *      attachment 0 => albedo (RGBA8, alpha = 1 for emissive surfaces like the Sun)
+ *      attachment 1 => world space normal (RGBA16F)
+ *      depth        => DEPTH_COMPONENT24 texture, world position is rebuilt from it
+ */
+class GBuffer
+{
+public:
+    GBuffer(int width, int height);
+    ~GBuffer();
+
+    GBuffer(const GBuffer &) = delete;
+    GBuffer &operator=(const GBuffer &) = delete;
+
+    void Bind() const;
+    void UnBind() const;
+
+    // recreates the attachments when the framebuffer size changed
+    void Resize(int width, int height);
+
+    // albedo -> firstUnit, normal -> firstUnit + 1, depth -> firstUnit + 2
+    void BindTextures(GLenum firstUnit = GL_TEXTURE0) const;
+
+    inline int GetWidth() const { return m_Width; }
+    inline int GetHeight() const { return m_Height; }
+
+    static std::unique_ptr<GBuffer> Create(int width, int height);
+
+private:
+    void Invalidate();
+    void Release();
+
+private:
+    GLuint m_FramebufferID;
+    GLuint m_AlbedoTexture;
+    GLuint m_NormalTexture;
+    GLuint m_DepthTexture;
+    int m_Width;
+    int m_Height;
+};
+
+#endif
@@ -8,18 +8,26 @@ class IndexBuffer
 {
 public:
     IndexBuffer(const std::vector<unsigned int> &vecIndexBufferData);
+    // dynamic buffer (GL_DYNAMIC_DRAW) with room for 'maxCount' indices, filled later via SetData
+    IndexBuffer(uint32_t maxCount);
     ~IndexBuffer();
 
     void Bind() const;
     void UnBind() const;
 
+    // replaces the index data, GetCount() follows the new size
+    void SetData(const std::vector<unsigned int> &vecIndexBufferData);
+
     inline uint32_t GetCount() const { return m_Count; }
 
     static std::shared_ptr<IndexBuffer> Create(const std::vector<unsigned int> &vecIndexBufferData);
+    static std::shared_ptr<IndexBuffer> Create(uint32_t maxCount);
 
 private:
     uint32_t m_IndexBufferID;
     uint32_t m_Count;
+    uint32_t m_Capacity; // indices the GL storage can hold
+    bool m_Dynamic;
 };
 
-#endif
\ No newline at end of file
+#endif
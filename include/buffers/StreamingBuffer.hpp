@@ -0,0 +1,84 @@
+#ifndef STREAMING_BUFFER_HPP
+#define STREAMING_BUFFER_HPP
+
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl3.h>
+#include <memory>
+#include <vector>
+#include "BufferLayout.hpp"
+
+/**
+ * A chunk of the ring handed out for the current frame
+ *      m_Data   => CPU write pointer (valid until Unmap/EndFrame)
+ *      m_Offset => byte offset inside the GL buffer (use for attribute pointers / draw offsets)
+ */
+struct StreamingAllocation
+{
+    void *m_Data;
+    GLintptr m_Offset;
+    GLsizeiptr m_Size;
+};
+
+/**
+ * Per-frame streaming buffer (instance data, particles, debug lines)
+ * One GL buffer split into m_FrameCount regions (triple buffered by default)
+ *      BeginFrame => waits on the fence of the region we are about to reuse
+ *      Map/Upload => bump allocates inside the current region
+ *      EndFrame   => fences the region so the CPU never overwrites data the GPU still reads
+ *
+ * Uses persistent coherent mapping when the context supports buffer storage (GL 4.4+),
+ * otherwise falls back to glMapBufferRange with GL_MAP_UNSYNCHRONIZED_BIT (macOS GL 4.1)
+ */
+class StreamingBuffer
+{
+public:
+    StreamingBuffer(GLenum target, GLsizeiptr frameCapacity, uint32_t frameCount = 3);
+    ~StreamingBuffer();
+
+    StreamingBuffer(const StreamingBuffer &) = delete;
+    StreamingBuffer &operator=(const StreamingBuffer &) = delete;
+
+    void Bind() const;
+    void UnBind() const;
+
+    void BeginFrame();
+    void EndFrame();
+
+    // write pointer for 'size' bytes, call Unmap() once the data is written
+    StreamingAllocation Map(GLsizeiptr size, GLsizeiptr alignment = 16);
+    void Unmap();
+
+    // copies data into the ring and returns its byte offset in the buffer
+    GLintptr Upload(const void *data, GLsizeiptr size, GLsizeiptr alignment = 16);
+
+    void SetLayout(const BufferLayout &layout) { m_Layout = layout; }
+    BufferLayout &GetLayout() { return m_Layout; }
+
+    inline GLuint GetID() const { return m_BufferID; }
+    inline GLenum GetTarget() const { return m_Target; }
+    inline GLsizeiptr GetFrameCapacity() const { return m_FrameCapacity; }
+    inline GLintptr GetFrameBaseOffset() const { return m_FrameIndex * m_FrameCapacity; }
+    inline GLsizeiptr GetFrameUsed() const { return m_FrameHead; }
+    inline bool IsPersistent() const { return m_PersistentData != nullptr; }
+
+    static std::shared_ptr<StreamingBuffer> Create(GLenum target, GLsizeiptr frameCapacity, uint32_t frameCount = 3);
+
+private:
+    void WaitForFence(GLsync &fence);
+
+private:
+    GLuint m_BufferID;
+    GLenum m_Target;
+    GLsizeiptr m_FrameCapacity; // bytes per frame region
+    uint32_t m_FrameCount;
+    uint32_t m_FrameIndex;
+    GLsizeiptr m_FrameHead; // bump pointer inside the current region
+
+    std::vector<GLsync> m_Fences;
+    unsigned char *m_PersistentData; // non-null when persistently mapped
+    bool m_Mapped;
+
+    BufferLayout m_Layout;
+};
+
+#endif
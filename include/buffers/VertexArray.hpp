@@ -5,6 +5,7 @@
 #include <vector>
 #include "VertexBuffer.hpp"
 #include "IndexBuffer.hpp"
+#include "StreamingBuffer.hpp"
 
 class VertexArray
 {
@@ -15,19 +16,40 @@ public:
     void Bind() const;
     void UnBind() const;
 
+    // attribute locations continue from the previous buffer
+    // e.g. sphere mesh (0..2) + per-instance model matrix (3..6)
     void AddVertexBuffer(const std::shared_ptr<VertexBuffer> &vertexBuffer);
     void SetIndexBuffer(const std::shared_ptr<IndexBuffer> &indexBuffer);
     void AddVertexBuffer(const VertexBuffer &vertexBuffer);
     void SetIndexBuffer(const IndexBuffer &indexBuffer);
 
+    // streaming buffers move every frame (or draw), call SetStreamingOffset after each Map/Upload
+    void AddStreamingBuffer(const std::shared_ptr<StreamingBuffer> &streamingBuffer);
+    void SetStreamingOffset(const std::shared_ptr<StreamingBuffer> &streamingBuffer, GLintptr baseOffset);
+
     const std::vector<std::shared_ptr<VertexBuffer>> &GetVertexBufferRefs() const { return m_VertexBuffersRefs; }
     const std::shared_ptr<IndexBuffer> &GetIndexBufferRefs() const { return m_IndexBufferRef; }
+    inline GLuint GetAttributeCount() const { return m_VertexAttribIndex; }
 
     static std::shared_ptr<VertexArray> Create();
 
 private:
+    // returns the number of attribute locations used by the layout
+    // pointersOnly skips enable/divisor state for attributes that were set up before
+    GLuint SetAttributePointers(const BufferLayout &layout, GLuint firstIndex, GLintptr baseOffset,
+                                bool pointersOnly = false);
+
+private:
+    struct StreamingBinding
+    {
+        std::shared_ptr<StreamingBuffer> m_Buffer;
+        GLuint m_FirstIndex;
+    };
+
     uint32_t m_VertexArrayID;
+    GLuint m_VertexAttribIndex; // next free attribute location
     std::vector<std::shared_ptr<VertexBuffer>> m_VertexBuffersRefs;
+    std::vector<StreamingBinding> m_StreamingBuffers;
     std::shared_ptr<IndexBuffer> m_IndexBufferRef;
 };
 
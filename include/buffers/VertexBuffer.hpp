@@ -9,19 +9,30 @@ class VertexBuffer
 {
 public:
     VertexBuffer(const std::vector<float> &vecBufferData);
+    // dynamic buffer (GL_DYNAMIC_DRAW) with 'size' bytes reserved, filled later via SetData
+    VertexBuffer(uint32_t size);
     ~VertexBuffer();
 
     void Bind() const;
     void UnBind() const;
 
+    // replaces 'size' bytes at 'offset', grows the buffer when needed (earlier bytes are kept)
+    void SetData(const void *data, uint32_t size, uint32_t offset = 0);
+
     void SetLayout(const BufferLayout &layout) { m_Layout = layout; }
     BufferLayout &GetLayout() { return m_Layout; }
 
+    inline uint32_t GetID() const { return m_VertexBufferID; }
+    inline uint32_t GetSize() const { return m_Size; }
+
     static std::shared_ptr<VertexBuffer> Create(const std::vector<float> &vecBufferData);
+    static std::shared_ptr<VertexBuffer> Create(uint32_t size);
 
 private:
     uint32_t m_VertexBufferID;
+    uint32_t m_Size;       // bytes
+    GLenum m_Usage;        // GL_STATIC_DRAW or GL_DYNAMIC_DRAW
     BufferLayout m_Layout; // to retrieve buffer layout from vertex buffer
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -41,7 +41,7 @@ public:
 
     virtual EventType GetType() const = 0;
     virtual uint32_t GetCategoryFlags() const = 0;
-    virtual std::string ToString() const = 0;
+    // concrete events have a non-virtual ToString, use ToString(const QueuedEvent &) for queued ones
 
     bool IsInCategory(EventCategory category) const
     {
@@ -51,12 +51,6 @@ public:
     bool IsHandled() const { return m_Handled; }
     void SetHandled(bool handled) { m_Handled = handled; }
 
-    friend std::ostream &operator<<(std::ostream &os, const Event &event)
-    {
-        os << event.ToString();
-        return os;
-    }
-
 protected:
     bool m_Handled = false;
 };
@@ -0,0 +1,66 @@
+#ifndef EVENT_QUEUE_HPP
+#define EVENT_QUEUE_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "events/KeyEvent.hpp"
+#include "events/MouseEvent.hpp"
+#include "events/WindowEvent.hpp"
+
+// every event the window can produce, stored by value
+using QueuedEvent = std::variant<KeyPressedEvent, KeyReleasedEvent, KeyRepeatEvent, MouseButtonPressedEvent,
+                                 MouseButtonReleasedEvent, MouseMovedEvent, MouseScrolledEvent, WindowResizedEvent,
+                                 WindowClosedEvent>;
+
+std::string ToString(const QueuedEvent &event);
+
+/**
+ * Per-frame event queue, filled by the GLFW callbacks during glfwPollEvents and drained once per frame
+ *      Push     => stores the event, a mouse move or resize right after another one replaces it
+ *      Dispatch => hands the batch to 'handler' in arrival order
+ * The vectors are reused every frame so nothing is allocated once they reach their high-water mark.
+ * Main thread only, GLFW never calls back from anywhere else.
+ */
+class EventQueue
+{
+public:
+    explicit EventQueue(std::size_t capacity = 256);
+
+    void Push(const QueuedEvent &event);
+    // drops queued keyboard/mouse events, window events stay (input replay)
+    void DiscardInput();
+
+    // handler is called with the concrete event type (or anything it converts to, e.g. Event &)
+    template <typename F>
+    void Dispatch(F &&handler)
+    {
+        // anything a handler pushes goes into the next frame's batch
+        std::swap(m_Pending, m_Dispatching);
+        m_LastDispatched = static_cast<uint32_t>(m_Dispatching.size());
+        m_LastCoalesced = m_Coalesced;
+        m_Coalesced = 0;
+
+        for (QueuedEvent &event : m_Dispatching)
+            std::visit([&handler](auto &concrete)
+                       { handler(concrete); },
+                       event);
+        m_Dispatching.clear();
+    }
+
+    inline const std::vector<QueuedEvent> &GetPending() const { return m_Pending; }
+    inline std::size_t GetPendingCount() const { return m_Pending.size(); }
+    inline uint32_t GetLastDispatchedCount() const { return m_LastDispatched; }
+    inline uint32_t GetLastCoalescedCount() const { return m_LastCoalesced; }
+
+private:
+    std::vector<QueuedEvent> m_Pending;
+    std::vector<QueuedEvent> m_Dispatching;
+    uint32_t m_Coalesced;
+    uint32_t m_LastDispatched;
+    uint32_t m_LastCoalesced;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef EVENT_TABLE_HPP
+#define EVENT_TABLE_HPP
+
+#include <array>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "events/Event.hpp"
+#include "Profiler.hpp"
+
+/**
+ * Flat dispatch table, one handler list per EventType in delivery order (topmost layer first)
+ * Layers fill it in Layer::SubscribeEvents, LayerStack rebuilds it whenever a layer is pushed or popped,
+ * so delivering an event is a single indexed lookup and only subscribed layers are called.
+ */
+class EventTable
+{
+public:
+    static constexpr std::size_t EVENT_TYPE_COUNT = static_cast<std::size_t>(Event::EventType::WindowClosed) + 1;
+
+    // returns true when the event is handled and should stop propagating
+    using Handler = std::function<bool(Event &)>;
+
+    struct Subscription
+    {
+        const char *name; // subscriber name for profiling, interned so trace events can outlive the layer
+        Handler handler;
+    };
+
+    // T = concrete event type, handler takes T & and returns bool
+    template <typename T, typename F>
+    void Subscribe(const char *name, F &&handler)
+    {
+        // the type is fixed by the slot, so the downcast needs no runtime check
+        m_Table[Index(T::GetStaticType())].push_back(
+            {Profiler::Intern(name), [handler = std::forward<F>(handler)](Event &event) mutable
+             { return handler(static_cast<T &>(event)); }});
+    }
+
+    void Clear()
+    {
+        for (auto &subscriptions : m_Table)
+            subscriptions.clear();
+    }
+
+    inline const std::vector<Subscription> &GetSubscriptions(Event::EventType type) const { return m_Table[Index(type)]; }
+
+private:
+    static constexpr std::size_t Index(Event::EventType type) { return static_cast<std::size_t>(type); }
+
+private:
+    std::array<std::vector<Subscription>, EVENT_TYPE_COUNT> m_Table;
+};
+
+#endif
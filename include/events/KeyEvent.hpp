@@ -30,13 +30,15 @@ public:
     static EventType GetStaticType() { return EventType::KeyPressed; }
     EventType GetType() const override { return GetStaticType(); }
 
-    std::string ToString() const override
+    std::string ToString() const
     {
         std::ostringstream oss;
         oss << "KeyPressedEvent: " << m_KeyCode;
         return oss.str();
     }
 
+    bool IsRepeat() const { return m_IsRepeat; }
+
 private:
     bool m_IsRepeat;
 };
@@ -49,7 +51,7 @@ public:
     static EventType GetStaticType() { return EventType::KeyReleased; }
     EventType GetType() const override { return GetStaticType(); }
 
-    std::string ToString() const override
+    std::string ToString() const
     {
         std::ostringstream oss;
         oss << "KeyReleasedEvent: " << m_KeyCode;
@@ -65,7 +67,7 @@ public:
     static EventType GetStaticType() { return EventType::KeyRepeat; }
     EventType GetType() const override { return GetStaticType(); }
 
-    std::string ToString() const override
+    std::string ToString() const
     {
         std::ostringstream oss;
         oss << "KeyRepeatEvent: " << m_KeyCode;
@@ -30,7 +30,7 @@ public:
     static EventType GetStaticType() { return EventType::MouseMoved; }
     EventType GetType() const override { return GetStaticType(); }
 
-    std::string ToString() const override
+    std::string ToString() const
     {
         std::ostringstream oss;
         oss << "MouseMovedEvent: (" << m_X << ", " << m_Y << ")";
@@ -63,7 +63,7 @@ public:
     static EventType GetStaticType() { return EventType::MouseButtonPressed; }
     EventType GetType() const override { return GetStaticType(); }
 
-    std::string ToString() const override
+    std::string ToString() const
     {
         std::ostringstream oss;
         oss << "MouseButtonPressedEvent: " << m_Button;
@@ -79,7 +79,7 @@ public:
     static EventType GetStaticType() { return EventType::MouseButtonReleased; }
     EventType GetType() const override { return GetStaticType(); }
 
-    std::string ToString() const override
+    std::string ToString() const
     {
         std::ostringstream oss;
         oss << "MouseButtonReleasedEvent: " << m_Button;
@@ -101,7 +101,7 @@ public:
         return static_cast<uint32_t>(EventCategory::Mouse);
     }
 
-    std::string ToString() const override
+    std::string ToString() const
     {
         std::ostringstream oss;
         oss << "MouseScrolledEvent: (" << m_XOffset << ", " << m_YOffset << ")";
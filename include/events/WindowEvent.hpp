@@ -18,7 +18,7 @@ public:
         return static_cast<uint32_t>(EventCategory::Window);
     }
 
-    std::string ToString() const override
+    std::string ToString() const
     {
         std::ostringstream oss;
         oss << "WindowResizedEvent: " << m_Width << "x" << m_Height;
@@ -45,7 +45,7 @@ public:
         return static_cast<uint32_t>(EventCategory::Window);
     }
 
-    std::string ToString() const override
+    std::string ToString() const
     {
         return "WindowClosedEvent";
     }
@@ -4,6 +4,8 @@
 #include "Layer.hpp"
 #include <memory>
 #include "audio/Audio.hpp"
+#include "audio/MP3Decoder.hpp"
+#include "JobSystem.hpp"
 
 class AudioLayer : public Layer
 {
@@ -18,8 +20,17 @@ public:
 
     const std::shared_ptr<Audio> GetAudio() const { return m_Audio; }
 
+private:
+    static void DecodeJob(void *data, uint32_t begin, uint32_t end);
+
 private:
     std::shared_ptr<Audio> m_Audio;
+
+    // the mp3 is decoded on the job system, playback starts in the first OnUpdate after it finished
+    std::string m_AudioPath;
+    std::unique_ptr<MP3Decoder> m_Decoder;
+    JobCounter m_DecodeCounter;
+    bool m_Decoded;
 };
 
 #endif
@@ -6,7 +6,8 @@
 #include "buffers/IndexBuffer.hpp"
 #include "buffers/VertexArray.hpp"
 #include "Shader.hpp"
-#include "Texture.hpp";
+#include "Texture.hpp"
+#include "ResourceManager.hpp"
 
 class ExampleLayer : public Layer
 {
@@ -23,8 +24,8 @@ private:
     std::shared_ptr<VertexBuffer> m_VBO;
     std::shared_ptr<IndexBuffer> m_EBO;
     std::shared_ptr<VertexArray> m_VAO;
-    std::unique_ptr<ShaderManager> m_ShaderManager;
-    std::unique_ptr<TextureManager> m_TextureManager;
+    ShaderHandle m_Shader;
+    TextureHandle m_Texture; // shares the solar system's earth.jpg
 
     glm::mat4 m_Model;
     glm::mat4 m_View;
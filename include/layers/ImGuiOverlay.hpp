@@ -3,11 +3,14 @@
 
 #include "Layer.hpp"
 #include "Time.hpp"
+#include "ResourceManager.hpp"
+#include <vector>
 
 class ImGuiOverlay : public Layer
 {
 private:
     Time m_Time;
+    std::vector<TextureInfo> m_TextureRows; // reused every frame by the resources panel
 
 public:
     ImGuiOverlay();
@@ -22,6 +25,7 @@ private:
     void ShowLayerManagementUI();
     void ShowPerformanceMetrics();
     void ShowGraphicsAndAudioInfo();
+    void ShowRenderSettings();
     void ShowDockingSpace();
 };
 
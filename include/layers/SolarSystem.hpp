@@ -9,12 +9,18 @@
 #include "Camera.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "ResourceManager.hpp"
 
 #include "buffers/VertexBuffer.hpp"
 #include "buffers/IndexBuffer.hpp"
 #include "buffers/VertexArray.hpp"
+#include "buffers/StreamingBuffer.hpp"
+#include "buffers/GBuffer.hpp"
+#include "LightGrid.hpp"
+#include "QueryRing.hpp"
+#include "FrameArena.hpp"
 
-#include "events/MouseEvent.hpp"
+#include "events/KeyEvent.hpp"
 
 struct CelestialBody
 {
@@ -26,37 +32,117 @@ struct CelestialBody
     float orbitalSpeed;
 };
 
+// one sphere to draw this frame, either as a mesh or as a ray-cast impostor
+struct BodyDrawCommand
+{
+    glm::mat4 model;
+    glm::mat3 normalMatrix; // unused by impostors
+    Texture *texture;
+    bool isSun;
+};
+
+// tweakable from the ImGui overlay
+struct SolarSystemRenderSettings
+{
+    // bodies smaller than this on screen (radius in pixels) are drawn as impostors
+    bool impostors = true;
+    float impostorPixelThreshold = 24.0f;
+
+    // G-buffer + tiled lighting pass instead of clustered forward Phong
+    bool deferredShading = false;
+    int pointLightCount = 64;
+
+    // draw order, see SolarSystemLayer::OnRender
+    bool skyboxLast = true;
+    bool depthPrePass = false;
+};
+
+// demo point light (spacecraft beacon) circling the Sun
+struct PointLightOrbit
+{
+    float radius;
+    float height;
+    float speed;
+    float phase;
+};
+
 class SolarSystemLayer : public Layer
 {
 public:
-    SolarSystemLayer();
+    // proceduralGeometry: spheres and orbits are generated in the vertex shaders
+    // instead of being built on the CPU and uploaded as vertex buffers
+    explicit SolarSystemLayer(bool proceduralGeometry = true);
     virtual ~SolarSystemLayer();
 
     virtual void OnAttach() override;
     virtual void OnDetach() override;
     virtual void OnUpdate(float deltaTime) override;
     virtual void OnRender() override;
-    virtual void OnEvent(Event &event) override;
 
     const inline std::vector<CelestialBody> &GetCelestialBodies() const
     {
         return m_CelestialBodies;
     }
 
+    inline SolarSystemRenderSettings &GetRenderSettings() { return m_RenderSettings; }
+    inline std::size_t GetMaxPointLights() const { return m_PointLights.size(); }
+
+    // samples that passed the depth test, read back a few frames late
+    inline GLuint64 GetSkyboxSamples() const { return m_SkyboxSamples->GetLastResult(); }
+    inline GLuint64 GetBodySamples() const { return m_BodySamples->GetLastResult(); }
+
 private:
+    void DrawSkybox();
+    void DrawOrbits();
+    void RenderDepthPrePass();
+    void DrawBodies();
+
+    void CreateMeshGeometry();
+    void CreateProceduralGeometry();
+    void DrawSphere() const;
+
+    // splits bodies into mesh and impostor draws based on projected size
+    void BuildBodyDrawCommands();
+    bool IsImpostor(const glm::mat4 &model, float viewportHeight) const;
+    void DrawImpostors();
+
+    // deferred path
+    void GeneratePointLights(int count);
+    void UpdatePointLights();
+    void RenderGeometryPass();
+    void RenderLightingPass();
+    // point light textures and cluster uniforms shared by the Phong and impostor shaders
+    void BindLightGrid(Shader &shader, const LightGrid &grid) const;
+    std::size_t GetActivePointLightCount() const;
+
     void GenerateSphere(
         std::vector<float> &vertices,
         std::vector<unsigned int> &indices,
         float radius, int sectorCount, int stackCount);
     void GenerateOrbitLine(std::vector<float> &vertices, float radius, int segmentCount);
 
-    // Eventhandlers
-    bool OnMouseMove(MouseMovedEvent &e);
+    // indices into m_Shaders
+    enum SolarSystemShader
+    {
+        PHONG_SHADER = 0,
+        GBUFFER_SHADER,
+        DEPTH_SHADER,
+        GOURAUD_SHADER,
+        FLAT_SHADER,
+        ORBIT_SHADER,
+        SKYBOX_SHADER,
+        IMPOSTOR_SHADER,
+        DEFERRED_LIGHTING_SHADER,
+        SHADER_COUNT
+    };
+    Shader *GetShader(SolarSystemShader shader) const;
 
 private:
     Camera m_Camera;
-    std::unique_ptr<ShaderManager> m_ShaderManager;
-    std::unique_ptr<TextureManager> m_TextureManager;
+    // owned by the application's ResourceManager, released in OnDetach
+    ShaderHandle m_Shaders[SHADER_COUNT];
+    std::vector<TextureHandle> m_BodyTextures; // same order as m_CelestialBodies
+    TextureHandle m_MoonTexture;
 
     float m_Time;
     float m_OrbitalSpeedScale;
@@ -75,21 +161,42 @@ private:
     std::shared_ptr<VertexArray> m_SkyboxVAO;
     std::shared_ptr<VertexBuffer> m_SkyboxVBO;
 
-    std::vector<float> m_SphereVertices;
-    std::vector<float> m_OrbitLineVertices;
-    std::vector<unsigned int> m_SphereIndices;
+    bool m_ProceduralGeometry;
+    SolarSystemRenderSettings m_RenderSettings;
+
+    // attribute-less draws (fullscreen passes)
+    std::shared_ptr<VertexArray> m_EmptyVAO;
+    // impostor quads come from gl_VertexID, their per-body data is rewritten every frame into a fenced ring
+    std::shared_ptr<VertexArray> m_ImpostorVAO;
+    std::shared_ptr<StreamingBuffer> m_ImpostorInstances;
+    // rebuilt from the frame arena every frame, only valid until the next BuildBodyDrawCommands
+    FrameVector<BodyDrawCommand> m_BodyDraws;
+    FrameVector<BodyDrawCommand> m_ImpostorDraws;
+
+    std::unique_ptr<GBuffer> m_GBuffer;
+    std::unique_ptr<LightGrid> m_LightGrid;     // screen tiles, deferred lighting pass
+    std::unique_ptr<LightGrid> m_LightClusters; // froxels, forward Phong pass
+    std::vector<PointLight> m_PointLights;
+    std::vector<PointLightOrbit> m_PointLightOrbits;
+
+    std::unique_ptr<QueryRing> m_SkyboxSamples;
+    std::unique_ptr<QueryRing> m_BodySamples;
+
+    static constexpr float SPHERE_RADIUS = 0.5f;
+    static constexpr int SPHERE_SECTORS = 36;
+    static constexpr int SPHERE_STACKS = 18;
+    static constexpr int ORBIT_SEGMENTS = 100;
+    static constexpr float NEAR_PLANE = 0.1f;
+    static constexpr float FAR_PLANE = 1000.0f;
+
+    // glMultiDrawArrays ranges, one strip per body (mesh path only)
+    std::vector<GLint> m_OrbitFirsts;
+    std::vector<GLsizei> m_OrbitCounts;
 
     std::vector<CelestialBody> m_CelestialBodies;
-    std::vector<std::string> m_TextureNames;
 
     // Skybox Cubemap
     std::unique_ptr<Texture> m_CubemapTexture;
-
-    // Camera Mouse Movements
-    // TODO: implement mouse movements
-    float m_LastMouseX = 0.0f;
-    float m_LastMouseY = 0.0f;
-    bool m_FirstMouseMove = true;
 };
 
 #endif
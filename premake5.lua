@@ -1,3 +1,8 @@
+newoption {
+    trigger = "gl-stats",
+    description = "Count GL calls per category in Release builds"
+}
+
 workspace "macos-opengl"
     configurations { "Debug", "Release" }
     platforms { "x64", "arm64" }
@@ -41,4 +46,10 @@ project "macos-opengl"
 
     -- Release Configuration
     filter "configurations:Release"
-        optimize "On"
\ No newline at end of file
+        optimize "On"
+        defines { "NDEBUG" } -- GL_CALL compiles to direct GL calls
+        defines { "LOG_ACTIVE_LEVEL=2" } -- SPDLOG_LEVEL_INFO, LOG_TRACE/LOG_DEBUG compile out
+
+    -- GL call counters in any configuration (shown in ImGui and benchmark output)
+    filter "options:gl-stats"
+        defines { "GL_CALL_COUNTING=1" }
\ No newline at end of file
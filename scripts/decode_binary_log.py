@@ -0,0 +1,118 @@
+"""
+Usage: python decode_binary_log.py <binary_log.bin> [--stats]
+
+Formats a log written by BinaryLog (--binary-log) into text, records of all threads are merged by time.
+--stats prints how often every call site logged instead of the messages.
+"""
+
+import struct
+import sys
+
+
+FILE_MAGIC = b"BINLOG01"
+BLOCK_FORMAT = 1
+BLOCK_CHUNK = 2
+LEVEL_NAMES = ["trace", "debug", "info", "warning", "error", "critical", "off"]
+
+
+class Reader:
+    def __init__(self, data: bytes):
+        self.data = data
+        self.pos = 0
+
+    def done(self) -> bool:
+        return self.pos >= len(self.data)
+
+    def read(self, fmt: str):
+        values = struct.unpack_from("<" + fmt, self.data, self.pos)
+        self.pos += struct.calcsize("<" + fmt)
+        return values[0] if len(values) == 1 else values
+
+    def read_bytes(self, size: int) -> bytes:
+        chunk = self.data[self.pos:self.pos + size]
+        self.pos += size
+        return chunk
+
+    def read_string(self) -> str:
+        return self.read_bytes(self.read("H")).decode("utf-8", errors="replace")
+
+
+def read_arg(reader: Reader):
+    arg_type = reader.read("B")
+    if arg_type == 0:
+        return reader.read("q")
+    if arg_type == 1:
+        return reader.read("Q")
+    if arg_type == 2:
+        return reader.read("d")
+    if arg_type == 3:
+        return "true" if reader.read("B") else "false"  # fmt spells bools in lowercase
+    if arg_type == 4:
+        return reader.read_string()
+    raise ValueError(f"unknown argument type {arg_type} at byte {reader.pos}")
+
+
+def decode(path: str):
+    with open(path, "rb") as file:
+        reader = Reader(file.read())
+
+    if reader.read_bytes(len(FILE_MAGIC)) != FILE_MAGIC:
+        raise ValueError(f"{path} is not a binary log")
+
+    formats = {}
+    records = []
+    while not reader.done():
+        block = reader.read("B")
+        if block == BLOCK_FORMAT:
+            format_id, level, line = reader.read("IBI")
+            source = reader.read_string()
+            formats[format_id] = (level, f"{source}:{line}", reader.read_string())
+        elif block == BLOCK_CHUNK:
+            thread, size = reader.read("II")
+            chunk = Reader(reader.read_bytes(size))
+            while not chunk.done():
+                format_id, timestamp, arg_count = chunk.read("IQB")
+                args = [read_arg(chunk) for _ in range(arg_count)]
+                records.append((timestamp, thread, format_id, args))
+        else:
+            raise ValueError(f"unknown block type {block} at byte {reader.pos - 1}")
+
+    records.sort(key=lambda record: record[0])
+    return formats, records
+
+
+def format_record(formats: dict, record) -> str:
+    timestamp, thread, format_id, args = record
+    level, source, text = formats[format_id]
+    try:
+        # fmt's replacement field syntax is Python's, {:.3f} etc. carry over
+        message = text.format(*args)
+    except (ValueError, IndexError) as error:
+        message = f"{text} {args} ({error}, {source})"
+    return f"[{timestamp / 1e9:12.6f} s] [T{thread}] [{LEVEL_NAMES[level]}] {message}"
+
+
+def print_stats(formats: dict, records: list):
+    counts = {}
+    for record in records:
+        counts[record[2]] = counts.get(record[2], 0) + 1
+    for format_id, count in sorted(counts.items(), key=lambda item: -item[1]):
+        level, source, text = formats[format_id]
+        print(f"{count:10d}  {source:40s}  {text}")
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: python decode_binary_log.py <binary_log.bin> [--stats]")
+        sys.exit(1)
+
+    formats, records = decode(sys.argv[1])
+    if "--stats" in sys.argv:
+        print_stats(formats, records)
+        return
+    for record in records:
+        print(format_record(formats, record))
+
+
+if __name__ == "__main__":
+    main()
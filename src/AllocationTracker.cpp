@@ -0,0 +1,227 @@
+#include "AllocationTracker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "Logger.hpp"
+
+static constexpr std::size_t TAG_COUNT = static_cast<std::size_t>(AllocTag::Count);
+
+// one set for the frame thread and one shared by every other thread
+// zero-initialized before any dynamic initializer runs, so allocations during static init are safe
+struct TagCounters
+{
+    std::atomic<uint64_t> allocations[TAG_COUNT];
+    std::atomic<uint64_t> frees[TAG_COUNT];
+    std::atomic<uint64_t> bytes[TAG_COUNT];
+};
+
+static TagCounters s_FrameCounters;
+static TagCounters s_BackgroundCounters;
+static std::atomic<uint64_t> s_LiveAllocations;
+static thread_local AllocTag s_CurrentTag = AllocTag::Untagged;
+static thread_local TagCounters *s_ThreadCounters = &s_BackgroundCounters;
+
+AllocationTracker::FrameCounters AllocationTracker::s_LastFrame = {};
+AllocCounters AllocationTracker::s_LastFrameTotal = {};
+AllocationTracker::FrameCounters AllocationTracker::s_LastBackground = {};
+AllocCounters AllocationTracker::s_LastBackgroundTotal = {};
+
+const char *AllocTagName(AllocTag tag)
+{
+    static const char *names[] = {"Untagged", "Update", "Render", "UI", "Events", "Audio", "Resources", "Logging"};
+    return tag < AllocTag::Count ? names[static_cast<std::size_t>(tag)] : "Untracked";
+}
+
+void AllocationTracker::RecordAllocation(std::size_t size)
+{
+    s_LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (s_CurrentTag >= AllocTag::Count)
+        return;
+
+    std::size_t tag = static_cast<std::size_t>(s_CurrentTag);
+    s_ThreadCounters->allocations[tag].fetch_add(1, std::memory_order_relaxed);
+    s_ThreadCounters->bytes[tag].fetch_add(size, std::memory_order_relaxed);
+}
+
+void AllocationTracker::RecordFree()
+{
+    s_LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+    if (s_CurrentTag >= AllocTag::Count)
+        return;
+
+    s_ThreadCounters->frees[static_cast<std::size_t>(s_CurrentTag)].fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocTag AllocationTracker::GetCurrentTag()
+{
+    return s_CurrentTag;
+}
+
+void AllocationTracker::SetCurrentTag(AllocTag tag)
+{
+    s_CurrentTag = tag;
+}
+
+void AllocationTracker::SetFrameThread()
+{
+    s_ThreadCounters = &s_FrameCounters;
+}
+
+// moves the live counters into 'last' and returns their sum
+static AllocCounters Snapshot(TagCounters &live, AllocationTracker::FrameCounters &last)
+{
+    AllocCounters total = {0, 0, 0};
+    for (std::size_t tag = 0; tag < TAG_COUNT; tag++)
+    {
+        AllocCounters &counters = last[tag];
+        counters.allocations = live.allocations[tag].exchange(0, std::memory_order_relaxed);
+        counters.frees = live.frees[tag].exchange(0, std::memory_order_relaxed);
+        counters.bytes = live.bytes[tag].exchange(0, std::memory_order_relaxed);
+
+        total.allocations += counters.allocations;
+        total.frees += counters.frees;
+        total.bytes += counters.bytes;
+    }
+    return total;
+}
+
+AllocCounters AllocationTracker::EndFrame()
+{
+    s_LastBackgroundTotal = Snapshot(s_BackgroundCounters, s_LastBackground);
+    s_LastFrameTotal = Snapshot(s_FrameCounters, s_LastFrame);
+    return s_LastFrameTotal;
+}
+
+uint64_t AllocationTracker::GetLiveAllocations()
+{
+    return s_LiveAllocations.load(std::memory_order_relaxed);
+}
+
+void AllocationTracker::LogLastFrame(uint64_t frameIndex)
+{
+    AllocationScope untracked(AllocTag::Untracked);
+
+    Logger::Error("Frame {} allocated {} times ({} bytes)", frameIndex, s_LastFrameTotal.allocations, s_LastFrameTotal.bytes);
+    for (std::size_t tag = 0; tag < TAG_COUNT; tag++)
+        if (s_LastFrame[tag].allocations)
+            Logger::Error("    {}: {} allocations, {} bytes", AllocTagName(static_cast<AllocTag>(tag)),
+                          s_LastFrame[tag].allocations, s_LastFrame[tag].bytes);
+    if (s_LastBackgroundTotal.allocations)
+        Logger::Error("    other threads (not counted): {} allocations, {} bytes", s_LastBackgroundTotal.allocations,
+                      s_LastBackgroundTotal.bytes);
+}
+
+#if ALLOCATION_TRACKING
+
+// replaceable global allocation functions, all forms funnel into the same counters
+// (the aligned nothrow forms are forwarded to the aligned ones by the standard library)
+
+static void *TrackedAlloc(std::size_t size)
+{
+    void *ptr = std::malloc(size ? size : 1);
+    if (ptr)
+        AllocationTracker::RecordAllocation(size);
+    return ptr;
+}
+
+static void *TrackedAlignedAlloc(std::size_t size, std::align_val_t alignment)
+{
+    void *ptr = nullptr;
+    std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void *));
+    if (posix_memalign(&ptr, align, size ? size : 1) != 0)
+        return nullptr;
+    AllocationTracker::RecordAllocation(size);
+    return ptr;
+}
+
+static void TrackedFree(void *ptr)
+{
+    if (!ptr)
+        return;
+    AllocationTracker::RecordFree();
+    std::free(ptr);
+}
+
+// standard replacement behaviour: let the new-handler free memory and retry, throw once there is none
+static void *NewOrThrow(std::size_t size)
+{
+    for (;;)
+    {
+        if (void *ptr = TrackedAlloc(size))
+            return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+static void *AlignedNewOrThrow(std::size_t size, std::align_val_t alignment)
+{
+    for (;;)
+    {
+        if (void *ptr = TrackedAlignedAlloc(size, alignment))
+            return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    return NewOrThrow(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return NewOrThrow(size);
+}
+
+// the nothrow forms go through the same loop, a handler may still throw bad_alloc
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return NewOrThrow(size);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return NewOrThrow(size);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return AlignedNewOrThrow(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return AlignedNewOrThrow(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept { TrackedFree(ptr); }
+void operator delete[](void *ptr) noexcept { TrackedFree(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { TrackedFree(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { TrackedFree(ptr); }
+
+#endif
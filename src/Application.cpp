@@ -5,63 +5,105 @@
 #include "layers/ExampleLayer.hpp"
 #include "layers/AudioLayer.hpp"
 #include "Time.hpp"
+#include "GLCall.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
+#include "AllocationTracker.hpp"
+#include "BinaryLog.hpp"
+#include <cstring>
 
 Application *Application::s_Instance = nullptr;
 
-Application::Application()
+Application::Application(int argc, char **argv)
 {
     if (s_Instance)
         throw std::runtime_error("Application already exists!");
     s_Instance = this;
 
+    Profiler::SetThreadName("Main");
+    AllocationTracker::SetFrameThread();
+
+    // console I/O moves to a writer thread unless --log-sync is given
+    bool asyncLog = true;
+    LogOverflowPolicy logOverflow = LogOverflowPolicy::Drop;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--log-sync") == 0)
+            asyncLog = false;
+        else if (std::strcmp(argv[i], "--log-block") == 0)
+            logOverflow = LogOverflowPolicy::Block;
+    }
+    if (asyncLog)
+        Logger::StartAsync(logOverflow);
+
+    // per-frame diagnostics in binary form, decode with scripts/decode_binary_log.py
+    for (int i = 1; i < argc; i++)
+        if (std::strcmp(argv[i], "--binary-log") == 0)
+            BinaryLog::Open(i + 1 < argc && argv[i + 1][0] != '-' ? argv[i + 1] : "binary_log.bin");
+
+    m_JobSystem = JobSystem::FromCommandLine(argc, argv);
     m_Window = std::make_unique<Window>();
+    m_GpuProfiler = std::make_unique<GpuProfiler>(); // needs the GL context
+    m_ResourceManager = ResourceManager::FromCommandLine(*m_JobSystem, argc, argv);
 
-    // bound to Application::OnEvent
-    // In Window.cpp props.eventCallback(event) will call this method
-    m_Window->SetEventCallback(
-        [this](Event &event)
-        {
-            OnEvent(event);
-        });
+    m_Benchmark = Benchmark::FromCommandLine(argc, argv);
+    if (m_Benchmark)
+        m_Window->SetVSync(false); // measure the frame, not the display refresh
+
+    m_InputReplay = InputReplay::FromCommandLine(argc, argv);
+    if (!m_InputReplay)
+        m_InputRecorder = InputRecorder::FromCommandLine(argc, argv);
+
+    // GLFW callbacks only queue events, Run hands them to OnEvent in one batch per frame
+    m_Window->SetEventQueue(&m_EventQueue);
 
-    // TODO: make layer handling more robust
-    auto *layer1 = new SolarSystemLayer();
-    m_LayerStack.PushLayer(layer1);
+    // the stack owns the layers and detaches them when the application shuts down
+    m_LayerStack.PushLayer(std::make_unique<SolarSystemLayer>());
 
     // Hint: current added audio as a layer instead of overlay
     // Hint: Later synchronize audio with events in the Solar System layer
-    auto *layer2 = new AudioLayer();
-    m_LayerStack.PushLayer(layer2);
+    m_LayerStack.PushLayer(std::make_unique<AudioLayer>());
 
-    auto *layer3 = new ExampleLayer();
-    m_LayerStack.PushLayer(layer3);
+    m_LayerStack.PushLayer(std::make_unique<ExampleLayer>());
 
-    auto *overlay1 = new ImGuiOverlay();
-    m_LayerStack.PushOverlay(overlay1);
+    m_LayerStack.PushOverlay(std::make_unique<ImGuiOverlay>());
 }
 
 Application::~Application()
 {
     // Cleanup resources
-    Logger::Debug("Application shutting down");
+    LOG_DEBUG("Application shutting down");
+    BinaryLog::Close();
+    Logger::StopAsync();
 }
 
 void Application::OnEvent(Event &event)
 {
-    // Event registration
-    EventDispatcher dispatcher(event);
-    dispatcher.Dispatch<WindowClosedEvent>([this](WindowClosedEvent &e)
-                                           { return OnWindowClose(e); });
-    dispatcher.Dispatch<WindowResizedEvent>([this](WindowResizedEvent &e)
-                                            { return OnWindowResize(e); });
-
-    // Dispatch events to layers in reverse order (from topmost to bottommost)
-    for (auto it = m_LayerStack.end(); it != m_LayerStack.begin();)
+    // application level handling first
+    switch (event.GetType())
     {
-        (*--it)->OnEvent(event);
-        if (event.IsHandled())
+    case Event::EventType::WindowClosed:
+        event.SetHandled(OnWindowClose(static_cast<WindowClosedEvent &>(event)));
+        break;
+    case Event::EventType::WindowResized:
+        event.SetHandled(OnWindowResize(static_cast<WindowResizedEvent &>(event)));
+        break;
+    default:
+        break;
+    }
+    if (event.IsHandled())
+        return;
+
+    // only layers that subscribed to this type, already ordered topmost to bottommost
+    for (const auto &subscription : m_LayerStack.GetEventTable().GetSubscriptions(event.GetType()))
+    {
+        PROFILE_SCOPE_DETAIL("OnEvent", subscription.name);
+        AllocationScope allocationScope(AllocTag::Events);
+        if (subscription.handler(event))
+        {
+            event.SetHandled(true);
             break; // Stop propagation if the event is handled
+        }
     }
 }
 
@@ -69,29 +111,85 @@ void Application::Run()
 {
     while (m_Running)
     {
+        PROFILE_SCOPE("Frame");
+        m_FrameStats.BeginFrame();
+        m_FrameArena.BeginFrame();
+
         float time = static_cast<float>(glfwGetTime());
         Time deltaTime = time - m_LastFrameTime;
         m_LastFrameTime = time;
 
+        // layers advance by updateDelta, a replay substitutes the recorded value and a benchmark
+        // camera path a fixed step, so the simulation is identical however fast this machine
+        // renders (deltaTime stays measured)
+        float updateDelta = deltaTime;
+        if (m_Benchmark && m_Benchmark->GetCameraPath())
+            updateDelta = m_Benchmark->GetProps().fixedTimestep;
+        if (m_InputReplay)
+        {
+            if (!m_InputReplay->NextFrame(m_EventQueue, updateDelta))
+            {
+                Logger::Info("Input replay finished after {} frames", m_InputReplay->GetFrameCount());
+                break;
+            }
+        }
+        else if (m_InputRecorder)
+            m_InputRecorder->RecordFrame(m_EventQueue.GetPending(), updateDelta);
+
+        {
+            // input polled at the end of the previous frame, the Input snapshot sees every event first
+            PROFILE_SCOPE("DispatchEvents");
+            m_Input.BeginFrame();
+            m_EventQueue.Dispatch([this](Event &event)
+                                  {
+                                      m_Input.OnEvent(event);
+                                      OnEvent(event); });
+        }
+        if (m_Input.IsKeyDown(GLFW_KEY_ESCAPE))
+            m_Running = false;
+
         // Logger::Info("FPS: {}", 1 / deltaTime);
 
         // glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        GL_CALL(Draw, glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 
         if (!m_Minimized)
         {
-            for (Layer *layer : m_LayerStack)
-                if (layer->IsVisible())
-                    layer->OnUpdate(deltaTime);
-            for (Layer *layer : m_LayerStack)
-                if (layer->IsVisible())
-                    layer->OnRender();
+            m_ResourceManager->Update();
+            m_LayerStack.UpdateLayers(updateDelta);
+            m_LayerStack.RenderLayers();
+        }
+
+        m_GpuProfiler->EndFrame();
+        GLCallStats::EndFrame();
+        AllocCounters allocations = AllocationTracker::EndFrame();
+        m_FrameStats.EndFrame(deltaTime.GetMilliSeconds(), m_GpuProfiler->GetLastFrameMs());
+        m_JobSystem->EndFrame();
+
+        const FrameSample &sample = m_FrameStats.GetLastSample();
+        LOG_BINARY(spdlog::level::info, "frame {:.3f} ms cpu {:.3f} ms gpu {:.3f} ms draws {} tris {} allocs {}",
+                   sample.frameMs, sample.cpuMs, sample.gpuMs, sample.drawCalls, sample.triangles,
+                   allocations.allocations);
+
+        if (m_Benchmark)
+        {
+            // wait for the GPU so its work lands in this frame's time
+            PROFILE_SCOPE("glFinish");
+            GL_CALL(Other, glFinish());
+            m_Benchmark->AddFrame(deltaTime, allocations);
+            if (m_Benchmark->IsFinished())
+                m_Running = false;
         }
 
         m_Window->OnUpdate();
+    }
 
-        if (glfwGetKey(m_Window.get()->GetNativeWindow(), GLFW_KEY_ESCAPE))
-            m_Running = false;
+    if (m_Benchmark)
+    {
+        if (!m_Benchmark->Report())
+            m_ExitCode = 1;
+        m_GpuProfiler->DumpToFile("bench_gpu_timings.csv");
+        Profiler::WriteChromeTrace("bench_trace.json");
     }
 }
 
@@ -103,8 +201,8 @@ bool Application::OnWindowClose(WindowClosedEvent &e)
 
 bool Application::OnWindowResize(WindowResizedEvent &e)
 {
-    Logger::Debug("Width: {}", e.GetWidth());
-    Logger::Debug("Height: {}", e.GetHeight());
+    LOG_DEBUG("Width: {}", e.GetWidth());
+    LOG_DEBUG("Height: {}", e.GetHeight());
     if (e.GetWidth() == 0 && e.GetHeight() == 0)
     {
         m_Minimized = true;
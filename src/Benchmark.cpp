@@ -0,0 +1,202 @@
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include "GLCall.hpp"
+#include "Logger.hpp"
+
+#define GL_SILENCE_DEPRECATION
+#include <OpenGL/gl3.h>
+
+Benchmark::Benchmark(const BenchmarkProps &props)
+    : m_Props(props), m_FrameIndex(0), m_TotalAllocations(0), m_MaxAllocations(0), m_BackgroundAllocations(0),
+      m_AllocatingFrames(0)
+{
+    if (!m_Props.cameraPath.empty())
+    {
+        m_CameraPath = CameraPath::Create(m_Props.cameraPath);
+        if (m_Props.frames == 0)
+            m_Props.frames = static_cast<uint32_t>(m_CameraPath->GetDuration() / m_Props.fixedTimestep) + 1;
+        Logger::Info("Benchmark: flying {} ({:.1f} s at {:.4f} s per frame)", m_Props.cameraPath,
+                     m_CameraPath->GetDuration(), m_Props.fixedTimestep);
+    }
+    if (m_Props.frames == 0)
+        m_Props.frames = BenchmarkProps().frames;
+
+    // reserved up front, measured frames must not allocate
+    m_FrameTimes.reserve(m_Props.frames);
+    if (m_CameraPath)
+        m_FrameSections.reserve(m_Props.frames);
+    Logger::Info("Benchmark: {} frames after {} warmup frames", m_Props.frames, m_Props.warmupFrames);
+}
+
+float Benchmark::GetCameraPathTime(uint32_t frameIndex) const
+{
+    uint32_t measured = frameIndex > m_Props.warmupFrames ? frameIndex - m_Props.warmupFrames : 0;
+    return measured * m_Props.fixedTimestep;
+}
+
+void Benchmark::AddFrame(float deltaTime, const AllocCounters &allocations)
+{
+    if (m_FrameIndex++ < m_Props.warmupFrames)
+        return;
+    if (m_FrameTimes.empty())
+        GLCallStats::ResetTotals(); // averages exclude warmup
+    if (m_FrameTimes.size() >= m_Props.frames)
+        return;
+
+    m_FrameTimes.push_back(deltaTime);
+    if (m_CameraPath)
+        m_FrameSections.push_back(m_CameraPath->GetSectionIndex(GetCameraPathTime(m_FrameIndex - 1)));
+
+    m_TotalAllocations += allocations.allocations;
+    m_MaxAllocations = std::max(m_MaxAllocations, allocations.allocations);
+    m_BackgroundAllocations += AllocationTracker::GetLastBackgroundTotal().allocations;
+    if (allocations.allocations == 0)
+        return;
+
+    // steady state should be allocation free, show where the first offenders came from
+    if (m_AllocatingFrames++ < 10 && m_Props.assertNoAllocations)
+        AllocationTracker::LogLastFrame(m_FrameIndex);
+}
+
+bool Benchmark::IsFinished() const
+{
+    return m_FrameTimes.size() >= m_Props.frames;
+}
+
+bool Benchmark::Report() const
+{
+    if (m_FrameTimes.empty())
+    {
+        Logger::Warn("Benchmark: no frames recorded");
+        return false;
+    }
+
+    std::vector<float> sorted = m_FrameTimes;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](float p)
+    {
+        std::size_t index = static_cast<std::size_t>(p * (sorted.size() - 1));
+        return sorted[index] * 1000.0f;
+    };
+
+    float total = std::accumulate(sorted.begin(), sorted.end(), 0.0f);
+    float average = total / sorted.size() * 1000.0f;
+
+    const char *renderer = reinterpret_cast<const char *>(GL_CALL(Other, glGetString(GL_RENDERER)));
+
+    std::ofstream file(m_Props.outputPath);
+    auto write = [&file](const std::string &line)
+    {
+        Logger::Info("{}", line);
+        if (file.is_open())
+            file << line << "\n";
+    };
+
+    write(fmt::format("renderer: {}", renderer ? renderer : "unknown"));
+    write(fmt::format("frames: {}", sorted.size()));
+    write(fmt::format("avg_ms: {:.3f}", average));
+    write(fmt::format("min_ms: {:.3f}", sorted.front() * 1000.0f));
+    write(fmt::format("p50_ms: {:.3f}", percentile(0.50f)));
+    write(fmt::format("p95_ms: {:.3f}", percentile(0.95f)));
+    write(fmt::format("p99_ms: {:.3f}", percentile(0.99f)));
+    write(fmt::format("max_ms: {:.3f}", sorted.back() * 1000.0f));
+    write(fmt::format("avg_fps: {:.1f}", 1000.0f / average));
+
+    if (m_CameraPath)
+    {
+        write(fmt::format("camera_path: {}", m_Props.cameraPath));
+        const std::vector<std::string> &sections = m_CameraPath->GetSections();
+        for (uint32_t section = 0; section < sections.size(); section++)
+        {
+            std::vector<float> times;
+            for (std::size_t i = 0; i < m_FrameTimes.size(); i++)
+                if (m_FrameSections[i] == section)
+                    times.push_back(m_FrameTimes[i]);
+            if (times.empty())
+                continue;
+
+            std::sort(times.begin(), times.end());
+            float sectionAverage = std::accumulate(times.begin(), times.end(), 0.0f) / times.size() * 1000.0f;
+            float sectionP95 = times[static_cast<std::size_t>(0.95f * (times.size() - 1))] * 1000.0f;
+            write(fmt::format("section_{}_frames: {}", sections[section], times.size()));
+            write(fmt::format("section_{}_avg_ms: {:.3f}", sections[section], sectionAverage));
+            write(fmt::format("section_{}_p95_ms: {:.3f}", sections[section], sectionP95));
+        }
+    }
+
+    if (GLCallStats::IsEnabled() && GLCallStats::GetTotalFrames() > 0)
+    {
+        const auto &totals = GLCallStats::GetTotals();
+        double frames = static_cast<double>(GLCallStats::GetTotalFrames());
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < totals.size(); i++)
+        {
+            write(fmt::format("gl_calls_{}: {:.1f}", GLCallCategoryName(static_cast<GLCallCategory>(i)), totals[i] / frames));
+            total += totals[i];
+        }
+        write(fmt::format("gl_calls_per_frame: {:.1f}", total / frames));
+    }
+
+    if (AllocationTracker::IsEnabled())
+    {
+        write(fmt::format("allocations_per_frame: {:.2f}", static_cast<double>(m_TotalAllocations) / sorted.size()));
+        write(fmt::format("allocations_max: {}", m_MaxAllocations));
+        write(fmt::format("allocating_frames: {}", m_AllocatingFrames));
+        write(fmt::format("background_allocations_per_frame: {:.2f}",
+                          static_cast<double>(m_BackgroundAllocations) / sorted.size()));
+    }
+
+    bool passed = !(m_Props.assertNoAllocations && m_AllocatingFrames > 0);
+    write(fmt::format("result: {}", passed ? "passed" : "FAILED (steady-state frames allocated)"));
+    return passed;
+}
+
+// digits only, 1..UINT32_MAX
+static bool ParseFrameCount(const char *text, uint32_t &frames)
+{
+    if (!std::isdigit(static_cast<unsigned char>(text[0])))
+        return false;
+
+    char *end = nullptr;
+    errno = 0;
+    unsigned long value = std::strtoul(text, &end, 10);
+    if (errno != 0 || *end != '\0' || value == 0 || value > UINT32_MAX)
+        return false;
+
+    frames = static_cast<uint32_t>(value);
+    return true;
+}
+
+std::unique_ptr<Benchmark> Benchmark::FromCommandLine(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--benchmark") != 0)
+            continue;
+
+        BenchmarkProps props;
+        for (int j = 1; j < argc; j++)
+        {
+            if (std::strcmp(argv[j], "--assert-no-alloc") == 0)
+                props.assertNoAllocations = true;
+            else if (std::strcmp(argv[j], "--camera-path") == 0 && j + 1 < argc)
+                props.cameraPath = argv[j + 1];
+        }
+        bool framesGiven = i + 1 < argc && argv[i + 1][0] != '-';
+        if (framesGiven && !ParseFrameCount(argv[i + 1], props.frames))
+        {
+            Logger::Warn("--benchmark: '{}' is not a frame count, ignoring it", argv[i + 1]);
+            framesGiven = false;
+        }
+        if (!framesGiven && !props.cameraPath.empty())
+            props.frames = 0; // the whole path
+        return std::make_unique<Benchmark>(props);
+    }
+    return nullptr;
+}
@@ -0,0 +1,181 @@
+#include "BinaryLog.hpp"
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * File layout (native endianness), a magic followed by blocks that start with a BlockType byte
+ *      Format => uint32 id, uint8 level, uint32 line, uint16 + file, uint16 + format string
+ *      Chunk  => uint32 thread, uint32 size, records
+ * Record: uint32 format id, uint64 ns (Profiler clock), uint8 arg count, args (BinaryArgType + value)
+ */
+static constexpr char FILE_MAGIC[8] = {'B', 'I', 'N', 'L', 'O', 'G', '0', '1'};
+
+enum class BlockType : uint8_t
+{
+    Format = 1,
+    Chunk = 2
+};
+
+/**
+ * Owned by one thread, the spin lock is only contended while Close flushes it
+ * Buffers outlive their threads so Close still writes what exited threads logged
+ */
+struct BinaryLog::ThreadBuffer
+{
+    uint32_t threadID;
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    std::size_t used = 0;
+    unsigned char data[THREAD_BUFFER_SIZE];
+
+    explicit ThreadBuffer(uint32_t id) : threadID(id) {}
+};
+
+struct FormatEntry
+{
+    int level;
+    int line;
+    std::string file;
+    std::string format;
+};
+
+std::atomic<bool> BinaryLog::s_Open{false};
+
+static std::mutex s_BuffersMutex;
+static std::vector<std::unique_ptr<BinaryLog::ThreadBuffer>> s_Buffers;
+
+// guards the file and the format table
+static std::mutex s_FileMutex;
+static std::FILE *s_File = nullptr;
+static std::vector<FormatEntry> s_Formats;
+static std::size_t s_FormatsWritten = 0;
+
+template <typename T>
+static void WriteValue(std::FILE *file, const T &value)
+{
+    std::fwrite(&value, sizeof(T), 1, file);
+}
+
+static void WriteString(std::FILE *file, const std::string &text)
+{
+    uint16_t length = static_cast<uint16_t>(std::min<std::size_t>(text.size(), BinaryLog::MAX_STRING_LENGTH));
+    WriteValue(file, length);
+    std::fwrite(text.data(), 1, length, file);
+}
+
+// s_FileMutex must be held
+static void WritePendingFormats()
+{
+    for (; s_FormatsWritten < s_Formats.size(); s_FormatsWritten++)
+    {
+        const FormatEntry &entry = s_Formats[s_FormatsWritten];
+        WriteValue(s_File, BlockType::Format);
+        WriteValue(s_File, static_cast<uint32_t>(s_FormatsWritten));
+        WriteValue(s_File, static_cast<uint8_t>(entry.level));
+        WriteValue(s_File, static_cast<uint32_t>(entry.line));
+        WriteString(s_File, entry.file);
+        WriteString(s_File, entry.format);
+    }
+}
+
+// buffer lock must be held
+static void FlushBuffer(BinaryLog::ThreadBuffer &buffer)
+{
+    if (buffer.used == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(s_FileMutex);
+    if (s_File)
+    {
+        // formats first so every ID in the chunk is already known to the decoder
+        WritePendingFormats();
+        WriteValue(s_File, BlockType::Chunk);
+        WriteValue(s_File, buffer.threadID);
+        WriteValue(s_File, static_cast<uint32_t>(buffer.used));
+        std::fwrite(buffer.data, 1, buffer.used, s_File);
+    }
+    buffer.used = 0;
+}
+
+bool BinaryLog::Open(const std::string &path)
+{
+    Close();
+
+    std::lock_guard<std::mutex> lock(s_FileMutex);
+    s_File = std::fopen(path.c_str(), "wb");
+    if (!s_File)
+    {
+        Logger::Warn("BinaryLog: could not open {}", path);
+        return false;
+    }
+
+    std::fwrite(FILE_MAGIC, 1, sizeof(FILE_MAGIC), s_File);
+    s_FormatsWritten = 0; // a new file needs the whole table again
+    s_Open.store(true, std::memory_order_release);
+    Logger::Info("BinaryLog: recording to {}", path);
+    return true;
+}
+
+void BinaryLog::Close()
+{
+    if (!s_Open.exchange(false))
+        return;
+
+    std::lock_guard<std::mutex> buffersLock(s_BuffersMutex);
+    for (auto &buffer : s_Buffers)
+    {
+        while (buffer->lock.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+        FlushBuffer(*buffer);
+        buffer->lock.clear(std::memory_order_release);
+    }
+
+    std::lock_guard<std::mutex> lock(s_FileMutex);
+    WritePendingFormats();
+    std::fclose(s_File);
+    s_File = nullptr;
+}
+
+uint32_t BinaryLog::RegisterFormat(int level, const char *format, const char *file, int line)
+{
+    std::lock_guard<std::mutex> lock(s_FileMutex);
+    s_Formats.push_back({level, line, file, format});
+    return static_cast<uint32_t>(s_Formats.size() - 1);
+}
+
+BinaryLog::ThreadBuffer &BinaryLog::GetThreadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(s_BuffersMutex);
+        s_Buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(s_Buffers.size() + 1)));
+        buffer = s_Buffers.back().get();
+    }
+    return *buffer;
+}
+
+unsigned char *BinaryLog::Reserve(ThreadBuffer &buffer, std::size_t size)
+{
+    while (buffer.lock.test_and_set(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    // Close may have run between the IsOpen check and taking the lock
+    if (!IsOpen() || size > THREAD_BUFFER_SIZE)
+    {
+        buffer.lock.clear(std::memory_order_release);
+        return nullptr;
+    }
+
+    if (buffer.used + size > THREAD_BUFFER_SIZE)
+        FlushBuffer(buffer);
+    return buffer.data + buffer.used;
+}
+
+void BinaryLog::Commit(ThreadBuffer &buffer, std::size_t size)
+{
+    buffer.used += size;
+    buffer.lock.clear(std::memory_order_release);
+}
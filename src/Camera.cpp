@@ -1,6 +1,5 @@
 #include "Camera.hpp"
 #include <glm/gtc/matrix_transform.hpp>
-#include "Application.hpp"
 
 Camera::Camera()
     : m_Position(glm::vec3(0.0f, 20.0f, 70.0f)),
@@ -8,8 +7,8 @@ Camera::Camera()
       m_Up(0.0f, 0.5f, 0.0f),
       m_Yaw(-50.0f),
       m_Pitch(-20.0f),
-      m_Speed(0.2f),
-      m_RotationSpeed(0.3f),
+      m_Speed(12.0f),        // 0.2 per frame at 60 fps
+      m_RotationSpeed(18.0f), // 0.3 per frame at 60 fps
       m_Sensitivity(0.05f)
 {
 }
@@ -19,27 +18,28 @@ glm::mat4 Camera::GetViewMatrix() const
     return glm::lookAt(m_Position, m_Position + m_Front, m_Up);
 }
 
-void Camera::ProcessInput()
+void Camera::ProcessInput(const Input &input, float deltaTime)
 {
-    auto *window = Application::Get().GetWindow().GetNativeWindow();
     glm::vec3 Right = glm::normalize(glm::cross(m_Front, m_Up)); // Calculate right vector once
+    float distance = m_Speed * deltaTime;
+    float rotation = m_RotationSpeed * deltaTime;
 
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        m_Position += m_Speed * m_Front;
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        m_Position -= m_Speed * m_Front;
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        m_Position -= m_Speed * Right;
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        m_Position += m_Speed * Right;
-    if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
-        m_Position += m_Speed * m_Up;
-    if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
-        m_Position -= m_Speed * m_Up;
-    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
-        m_Yaw -= m_RotationSpeed;
-    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
-        m_Yaw += m_RotationSpeed;
+    if (input.IsKeyDown(GLFW_KEY_W))
+        m_Position += distance * m_Front;
+    if (input.IsKeyDown(GLFW_KEY_S))
+        m_Position -= distance * m_Front;
+    if (input.IsKeyDown(GLFW_KEY_A))
+        m_Position -= distance * Right;
+    if (input.IsKeyDown(GLFW_KEY_D))
+        m_Position += distance * Right;
+    if (input.IsKeyDown(GLFW_KEY_UP))
+        m_Position += distance * m_Up;
+    if (input.IsKeyDown(GLFW_KEY_DOWN))
+        m_Position -= distance * m_Up;
+    if (input.IsKeyDown(GLFW_KEY_LEFT))
+        m_Yaw -= rotation;
+    if (input.IsKeyDown(GLFW_KEY_RIGHT))
+        m_Yaw += rotation;
 
     glm::vec3 front;
     front.x = cos(glm::radians(m_Yaw)) * cos(glm::radians(m_Pitch));
@@ -59,3 +59,14 @@ void Camera::ProcessMouseMovement(float xOffset, float yOffset)
         sin(glm::radians(m_Pitch)),
         sin(glm::radians(m_Yaw)) * cos(glm::radians(m_Pitch))));
 }
+
+void Camera::SetPose(const glm::vec3 &position, float yaw, float pitch)
+{
+    m_Position = position;
+    m_Yaw = yaw;
+    m_Pitch = glm::clamp(pitch, -89.0f, 89.0f);
+    m_Front = glm::normalize(glm::vec3(
+        cos(glm::radians(m_Yaw)) * cos(glm::radians(m_Pitch)),
+        sin(glm::radians(m_Pitch)),
+        sin(glm::radians(m_Yaw)) * cos(glm::radians(m_Pitch))));
+}
@@ -0,0 +1,117 @@
+#include "CameraPath.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "Logger.hpp"
+
+template <typename T>
+static T Hermite(const T &p0, const T &m0, const T &p1, const T &m1, float span, float s)
+{
+    float s2 = s * s;
+    float s3 = s2 * s;
+    return (2.0f * s3 - 3.0f * s2 + 1.0f) * p0 + (s3 - 2.0f * s2 + s) * span * m0 +
+           (-2.0f * s3 + 3.0f * s2) * p1 + (s3 - s2) * span * m1;
+}
+
+static glm::vec2 Angles(const CameraKeyframe &key)
+{
+    return glm::vec2(key.yaw, key.pitch);
+}
+
+CameraPath::CameraPath(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        Logger::Critical("Failed to open camera path: {}", path);
+        throw std::runtime_error("Failed to open camera path: " + path);
+    }
+
+    std::string line;
+    for (int lineNumber = 1; std::getline(file, line); lineNumber++)
+    {
+        line = line.substr(0, line.find('#'));
+        std::istringstream stream(line);
+        CameraKeyframe key{};
+        if (!(stream >> key.time))
+            continue; // blank or comment
+
+        if (!(stream >> key.position.x >> key.position.y >> key.position.z >> key.yaw >> key.pitch))
+        {
+            Logger::Critical("{}:{}: expected 'time x y z yaw pitch [section]'", path, lineNumber);
+            throw std::runtime_error("Malformed camera path: " + path);
+        }
+        if (!m_Keyframes.empty() && key.time <= m_Keyframes.back().time)
+        {
+            Logger::Critical("{}:{}: keyframe times must increase", path, lineNumber);
+            throw std::runtime_error("Malformed camera path: " + path);
+        }
+
+        std::string section;
+        if (stream >> section)
+            m_Sections.push_back(section);
+        else if (m_Sections.empty())
+            m_Sections.push_back("path");
+        key.section = static_cast<uint32_t>(m_Sections.size() - 1);
+        m_Keyframes.push_back(key);
+    }
+
+    if (m_Keyframes.size() < 2)
+    {
+        Logger::Critical("Camera path {} needs at least two keyframes", path);
+        throw std::runtime_error("Camera path needs at least two keyframes: " + path);
+    }
+
+    LOG_DEBUG("Camera path {}: {} keyframes, {:.1f} s, {} sections", path, m_Keyframes.size(), GetDuration(),
+              m_Sections.size());
+}
+
+std::size_t CameraPath::FindSpan(float time) const
+{
+    auto next = std::upper_bound(m_Keyframes.begin(), m_Keyframes.end(), time,
+                                 [](float t, const CameraKeyframe &key)
+                                 { return t < key.time; });
+    std::size_t index = static_cast<std::size_t>(next - m_Keyframes.begin());
+    return std::min(index > 0 ? index - 1 : 0, m_Keyframes.size() - 2);
+}
+
+CameraPose CameraPath::Evaluate(float time) const
+{
+    time = std::clamp(time, m_Keyframes.front().time, GetDuration());
+
+    std::size_t i = FindSpan(time);
+    const CameraKeyframe &k0 = m_Keyframes[i];
+    const CameraKeyframe &k1 = m_Keyframes[i + 1];
+    // neighbours for the tangents, the ends reuse their own keyframe (one-sided difference)
+    const CameraKeyframe &before = m_Keyframes[i > 0 ? i - 1 : i];
+    const CameraKeyframe &after = m_Keyframes[std::min(i + 2, m_Keyframes.size() - 1)];
+
+    // non-uniform Catmull-Rom: tangent = central difference over the neighbours' time span
+    glm::vec3 m0 = (k1.position - before.position) / (k1.time - before.time);
+    glm::vec3 m1 = (after.position - k0.position) / (after.time - k0.time);
+    glm::vec2 a0 = (Angles(k1) - Angles(before)) / (k1.time - before.time);
+    glm::vec2 a1 = (Angles(after) - Angles(k0)) / (after.time - k0.time);
+
+    float span = k1.time - k0.time;
+    float s = (time - k0.time) / span;
+    glm::vec2 angles = Hermite(Angles(k0), a0, Angles(k1), a1, span, s);
+
+    CameraPose pose;
+    pose.position = Hermite(k0.position, m0, k1.position, m1, span, s);
+    pose.yaw = angles.x;
+    pose.pitch = glm::clamp(angles.y, -89.0f, 89.0f);
+    return pose;
+}
+
+uint32_t CameraPath::GetSectionIndex(float time) const
+{
+    if (time >= GetDuration())
+        return m_Keyframes.back().section;
+    return m_Keyframes[FindSpan(time)].section;
+}
+
+std::shared_ptr<CameraPath> CameraPath::Create(const std::string &path)
+{
+    return std::make_shared<CameraPath>(path);
+}
@@ -0,0 +1,47 @@
+#include "FrameArena.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include "Logger.hpp"
+
+LinearArena::LinearArena(std::size_t capacity)
+    : m_Memory(new unsigned char[capacity]), m_Capacity(capacity), m_Head(0), m_Peak(0)
+{
+}
+
+void *LinearArena::Allocate(std::size_t size, std::size_t alignment)
+{
+    uintptr_t base = reinterpret_cast<uintptr_t>(m_Memory.get());
+    std::size_t head = m_Head.load(std::memory_order_relaxed);
+    std::size_t offset;
+    do
+    {
+        offset = ((base + head + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+        if (offset + size > m_Capacity)
+        {
+            Logger::Critical("LinearArena overflow: {} + {} > {} bytes", offset, size, m_Capacity);
+            throw std::runtime_error("LinearArena overflow");
+        }
+    } while (!m_Head.compare_exchange_weak(head, offset + size, std::memory_order_relaxed));
+
+    return m_Memory.get() + offset;
+}
+
+void LinearArena::Reset()
+{
+    m_Peak = std::max(m_Peak, m_Head.load(std::memory_order_relaxed));
+    m_Head.store(0, std::memory_order_relaxed);
+}
+
+FrameArena::FrameArena(std::size_t capacityPerFrame)
+    : m_Current(0)
+{
+    for (auto &arena : m_Arenas)
+        arena = std::make_unique<LinearArena>(capacityPerFrame);
+}
+
+void FrameArena::BeginFrame()
+{
+    // the arena we switch to was last written two frames ago, nothing references it anymore
+    m_Current = (m_Current + 1) % BUFFER_COUNT;
+    m_Arenas[m_Current]->Reset();
+}
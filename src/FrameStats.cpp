@@ -0,0 +1,117 @@
+#include "FrameStats.hpp"
+#include <algorithm>
+#include "Logger.hpp"
+
+uint32_t FrameStats::s_DrawCalls = 0;
+uint32_t FrameStats::s_Triangles = 0;
+uint32_t FrameStats::s_UniformUploads = 0;
+
+FrameStats::FrameStats(float hitchBudgetMs)
+    : m_Samples(),
+      m_FrameTimes(),
+      m_Scratch(),
+      m_Histogram(),
+      m_Head(0),
+      m_Count(0),
+      m_FrameIndex(0),
+      m_FrameTimeSum(0.0f),
+      m_P50(0.0f),
+      m_P95(0.0f),
+      m_P99(0.0f),
+      m_HitchBudgetMs(hitchBudgetMs),
+      m_HitchCount(0)
+{
+}
+
+void FrameStats::BeginFrame()
+{
+    m_FrameStart = std::chrono::steady_clock::now();
+    s_DrawCalls = 0;
+    s_Triangles = 0;
+    s_UniformUploads = 0;
+}
+
+void FrameStats::EndFrame(float frameMs, float gpuMs)
+{
+    std::chrono::duration<float, std::milli> cpu = std::chrono::steady_clock::now() - m_FrameStart;
+    FrameSample sample = {frameMs, cpu.count(), gpuMs, s_DrawCalls, s_Triangles, s_UniformUploads};
+
+    // the overwritten sample leaves the sum and the histogram
+    if (m_Count == HISTORY_SIZE)
+    {
+        m_FrameTimeSum -= m_FrameTimes[m_Head];
+        m_Histogram[GetBucket(m_FrameTimes[m_Head])] -= 1.0f;
+    }
+    else
+        m_Count++;
+
+    m_Samples[m_Head] = sample;
+    m_FrameTimes[m_Head] = frameMs;
+    m_FrameTimeSum += frameMs;
+    m_Histogram[GetBucket(frameMs)] += 1.0f;
+    m_Head = (m_Head + 1) % HISTORY_SIZE;
+
+    UpdatePercentiles();
+
+    // the first frame includes startup (shader compilation, texture uploads)
+    if (m_FrameIndex++ > 0 && frameMs > m_HitchBudgetMs)
+    {
+        m_HitchCount++;
+        Logger::Warn("Hitch: frame {} took {:.2f} ms (budget {:.2f} ms, cpu {:.2f} ms, gpu {:.2f} ms, {} draws)",
+                     m_FrameIndex, frameMs, m_HitchBudgetMs, sample.cpuMs, gpuMs, sample.drawCalls);
+    }
+}
+
+void FrameStats::CountDraw(GLenum mode, GLsizei vertexCount, GLsizei instanceCount)
+{
+    uint32_t triangles = 0;
+    if (mode == GL_TRIANGLES)
+        triangles = vertexCount / 3;
+    else if ((mode == GL_TRIANGLE_STRIP || mode == GL_TRIANGLE_FAN) && vertexCount > 2)
+        triangles = vertexCount - 2;
+
+    s_DrawCalls++;
+    s_Triangles += triangles * instanceCount;
+}
+
+void FrameStats::CountDrawCalls(uint32_t drawCalls, uint32_t triangles)
+{
+    s_DrawCalls += drawCalls;
+    s_Triangles += triangles;
+}
+
+void FrameStats::SetHitchBudget(float budgetMs)
+{
+    m_HitchBudgetMs = std::max(budgetMs, 1.0f);
+
+    // bucket width changed, rebuild from the history
+    m_Histogram.fill(0.0f);
+    for (uint32_t i = 0; i < m_Count; i++)
+        m_Histogram[GetBucket(m_FrameTimes[i])] += 1.0f;
+}
+
+uint32_t FrameStats::GetBucket(float frameMs) const
+{
+    int bucket = static_cast<int>(frameMs / GetHistogramRangeMs() * HISTOGRAM_BUCKETS);
+    return static_cast<uint32_t>(std::clamp(bucket, 0, static_cast<int>(HISTOGRAM_BUCKETS) - 1));
+}
+
+void FrameStats::UpdatePercentiles()
+{
+    // until the ring wraps the valid samples are [0, m_Count)
+    std::copy(m_FrameTimes.begin(), m_FrameTimes.begin() + m_Count, m_Scratch.begin());
+
+    const float percentiles[3] = {0.50f, 0.95f, 0.99f};
+    float *results[3] = {&m_P50, &m_P95, &m_P99};
+
+    // ascending, so each nth_element only searches past the previous one
+    auto first = m_Scratch.begin();
+    auto last = m_Scratch.begin() + m_Count;
+    for (int i = 0; i < 3; i++)
+    {
+        auto nth = m_Scratch.begin() + static_cast<std::ptrdiff_t>(percentiles[i] * (m_Count - 1));
+        std::nth_element(first, nth, last);
+        *results[i] = *nth;
+        first = nth;
+    }
+}
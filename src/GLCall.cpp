@@ -0,0 +1,95 @@
+#include "GLCall.hpp"
+#include <cstring>
+#include "Logger.hpp"
+
+GLCallStats::Counters GLCallStats::s_Current = {};
+GLCallStats::Counters GLCallStats::s_LastFrame = {};
+GLCallStats::Counters GLCallStats::s_Totals = {};
+uint64_t GLCallStats::s_TotalFrames = 0;
+
+static bool s_DebugOutput = false;
+
+const char *GLCallCategoryName(GLCallCategory category)
+{
+    static const char *names[] = {"Draw", "State", "Bind", "Buffer", "Texture",
+                                  "Shader", "Uniform", "Query", "Framebuffer", "Other"};
+    return names[static_cast<std::size_t>(category)];
+}
+
+void GLCallStats::EndFrame()
+{
+    for (std::size_t i = 0; i < s_Current.size(); i++)
+        s_Totals[i] += s_Current[i];
+    s_TotalFrames++;
+
+    s_LastFrame = s_Current;
+    s_Current.fill(0);
+}
+
+void GLCallStats::ResetTotals()
+{
+    s_Totals.fill(0);
+    s_TotalFrames = 0;
+}
+
+static const char *GetErrorName(GLenum error)
+{
+    switch (error)
+    {
+    case GL_INVALID_ENUM:
+        return "GL_INVALID_ENUM";
+    case GL_INVALID_VALUE:
+        return "GL_INVALID_VALUE";
+    case GL_INVALID_OPERATION:
+        return "GL_INVALID_OPERATION";
+    case GL_INVALID_FRAMEBUFFER_OPERATION:
+        return "GL_INVALID_FRAMEBUFFER_OPERATION";
+    case GL_OUT_OF_MEMORY:
+        return "GL_OUT_OF_MEMORY";
+    default:
+        return "unknown error";
+    }
+}
+
+#ifdef GL_DEBUG_OUTPUT
+static void DebugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                 GLsizei length, const GLchar *message, const void *userParam)
+{
+    if (severity == GL_DEBUG_SEVERITY_NOTIFICATION)
+        return;
+    if (type == GL_DEBUG_TYPE_ERROR)
+        Logger::Error("GL debug ({}): {}", id, message);
+    else
+        Logger::Warn("GL debug ({}): {}", id, message);
+}
+#endif
+
+bool GLDebug::EnableDebugOutput()
+{
+#if defined(GL_DEBUG_OUTPUT) && GL_CALL_CHECKING
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 4 || (major == 4 && minor >= 3))
+    {
+        glEnable(GL_DEBUG_OUTPUT);
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+        glDebugMessageCallback(DebugMessageCallback, nullptr);
+        s_DebugOutput = true;
+        LOG_DEBUG("GL debug output enabled");
+    }
+#endif
+    return s_DebugOutput;
+}
+
+void GLDebug::CheckErrors(const char *call, const char *file, int line)
+{
+    if (s_DebugOutput)
+        return;
+
+    for (GLenum error = glGetError(); error != GL_NO_ERROR; error = glGetError())
+    {
+        const char *fileName = std::strrchr(file, '/');
+        Logger::Error("{} after {} ({}:{})", GetErrorName(error), call, fileName ? fileName + 1 : file, line);
+    }
+}
@@ -0,0 +1,124 @@
+#include "GpuProfiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include "Logger.hpp"
+
+GpuProfiler::GpuProfiler(uint32_t latency, uint32_t historySize)
+    : m_Latency(latency),
+      m_HistorySize(std::max(historySize, 1u)),
+      m_HistoryHead(0),
+      m_HistoryCount(0),
+      m_ActivePass(-1)
+{
+}
+
+void GpuProfiler::BeginPass(const char *name)
+{
+    if (m_ActivePass >= 0)
+    {
+        // GL_TIME_ELAPSED queries can't nest, close the outer pass instead of raising a GL error
+        Logger::Warn("GpuProfiler: '{}' started inside '{}'", name, m_Passes[m_ActivePass].name);
+        EndPass();
+    }
+
+    auto it = std::find_if(m_Passes.begin(), m_Passes.end(),
+                           [name](const Pass &pass)
+                           { return pass.name == name; });
+    if (it == m_Passes.end())
+    {
+        m_Passes.push_back({name, std::make_unique<QueryRing>(GL_TIME_ELAPSED, m_Latency),
+                            std::vector<float>(m_HistorySize, 0.0f)});
+        it = m_Passes.end() - 1;
+    }
+
+    m_ActivePass = static_cast<int>(it - m_Passes.begin());
+    it->timer->Begin();
+}
+
+void GpuProfiler::EndPass()
+{
+    if (m_ActivePass < 0)
+        return;
+
+    m_Passes[m_ActivePass].timer->End();
+    m_ActivePass = -1;
+}
+
+void GpuProfiler::EndFrame()
+{
+    // passes skipped this frame (or still in flight) repeat their last result
+    for (auto &pass : m_Passes)
+    {
+        pass.timer->Poll();
+        pass.history[m_HistoryHead] = pass.timer->GetLastResult() / 1.0e6f;
+    }
+
+    m_HistoryHead = (m_HistoryHead + 1) % m_HistorySize;
+    m_HistoryCount = std::min(m_HistoryCount + 1, m_HistorySize);
+}
+
+GpuPassStats GpuProfiler::GetPassStats(std::size_t pass) const
+{
+    const auto &history = m_Passes[pass].history;
+    GpuPassStats stats = {0.0f, 0.0f, 0.0f, 0.0f};
+    if (m_HistoryCount == 0)
+        return stats;
+
+    stats.lastMs = history[(m_HistoryHead + m_HistorySize - 1) % m_HistorySize];
+    stats.minMs = stats.maxMs = stats.lastMs;
+
+    float total = 0.0f;
+    for (uint32_t i = 0; i < m_HistoryCount; i++)
+    {
+        float sample = history[(m_HistoryHead + m_HistorySize - 1 - i) % m_HistorySize];
+        total += sample;
+        stats.minMs = std::min(stats.minMs, sample);
+        stats.maxMs = std::max(stats.maxMs, sample);
+    }
+    stats.averageMs = total / m_HistoryCount;
+    return stats;
+}
+
+float GpuProfiler::GetLastFrameMs() const
+{
+    uint32_t last = (m_HistoryHead + m_HistorySize - 1) % m_HistorySize;
+    float total = 0.0f;
+    for (const auto &pass : m_Passes)
+        total += pass.history[last];
+    return total;
+}
+
+bool GpuProfiler::DumpToFile(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        Logger::Warn("GpuProfiler: could not open {}", path);
+        return false;
+    }
+
+    file << "pass,avg_ms,min_ms,max_ms\n";
+    for (std::size_t pass = 0; pass < m_Passes.size(); pass++)
+    {
+        GpuPassStats stats = GetPassStats(pass);
+        file << fmt::format("{},{:.4f},{:.4f},{:.4f}\n", m_Passes[pass].name, stats.averageMs, stats.minMs, stats.maxMs);
+    }
+
+    // per-frame samples, oldest first
+    file << "\nframe";
+    for (const auto &pass : m_Passes)
+        file << "," << pass.name;
+    file << "\n";
+
+    uint32_t oldest = (m_HistoryHead + m_HistorySize - m_HistoryCount) % m_HistorySize;
+    for (uint32_t i = 0; i < m_HistoryCount; i++)
+    {
+        file << i;
+        for (const auto &pass : m_Passes)
+            file << fmt::format(",{:.4f}", pass.history[(oldest + i) % m_HistorySize]);
+        file << "\n";
+    }
+
+    Logger::Info("GpuProfiler: wrote {} frames to {}", m_HistoryCount, path);
+    return true;
+}
@@ -0,0 +1,78 @@
+#include "Input.hpp"
+#include "events/KeyEvent.hpp"
+#include "events/MouseEvent.hpp"
+
+Input::Input()
+    : m_MousePosition(0.0f),
+      m_PreviousMousePosition(0.0f),
+      m_ScrollDelta(0.0f),
+      m_HasMousePosition(false)
+{
+}
+
+void Input::BeginFrame()
+{
+    m_PressedKeys.reset();
+    m_ReleasedKeys.reset();
+    m_PreviousMousePosition = m_MousePosition;
+    m_ScrollDelta = glm::vec2(0.0f);
+}
+
+void Input::OnEvent(const Event &event)
+{
+    switch (event.GetType())
+    {
+    case Event::EventType::KeyPressed:
+    {
+        int key = static_cast<const KeyPressedEvent &>(event).GetKeyCode();
+        // repeats arrive while the key is already down and are not a new press
+        if (IsValidKey(key) && !m_Keys.test(key))
+        {
+            m_Keys.set(key);
+            m_PressedKeys.set(key);
+        }
+        break;
+    }
+    case Event::EventType::KeyReleased:
+    {
+        int key = static_cast<const KeyReleasedEvent &>(event).GetKeyCode();
+        if (IsValidKey(key) && m_Keys.test(key))
+        {
+            m_Keys.reset(key);
+            m_ReleasedKeys.set(key);
+        }
+        break;
+    }
+    case Event::EventType::MouseButtonPressed:
+    {
+        int button = static_cast<const MouseButtonPressedEvent &>(event).GetButton();
+        if (IsValidButton(button))
+            m_Buttons.set(button);
+        break;
+    }
+    case Event::EventType::MouseButtonReleased:
+    {
+        int button = static_cast<const MouseButtonReleasedEvent &>(event).GetButton();
+        if (IsValidButton(button))
+            m_Buttons.reset(button);
+        break;
+    }
+    case Event::EventType::MouseMoved:
+    {
+        const auto &moved = static_cast<const MouseMovedEvent &>(event);
+        m_MousePosition = glm::vec2(moved.GetX(), moved.GetY());
+        if (!m_HasMousePosition)
+            m_PreviousMousePosition = m_MousePosition;
+        m_HasMousePosition = true;
+        break;
+    }
+    case Event::EventType::MouseScrolled:
+    {
+        const auto &scrolled = static_cast<const MouseScrolledEvent &>(event);
+        m_ScrollDelta += glm::vec2(scrolled.GetXOffset(), scrolled.GetYOffset());
+        break;
+    }
+    default:
+        break;
+    }
+}
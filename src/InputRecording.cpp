@@ -0,0 +1,231 @@
+#include "InputRecording.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include "Logger.hpp"
+
+static constexpr char FILE_MAGIC[8] = {'I', 'N', 'P', 'R', 'E', 'C', '0', '1'};
+static constexpr const char *DEFAULT_PATH = "input_recording.bin";
+
+static const char *PathFromCommandLine(int argc, char **argv, const char *option)
+{
+    for (int i = 1; i < argc; i++)
+        if (std::strcmp(argv[i], option) == 0)
+            return i + 1 < argc && argv[i + 1][0] != '-' ? argv[i + 1] : DEFAULT_PATH;
+    return nullptr;
+}
+
+static bool IsInputEvent(const QueuedEvent &event)
+{
+    return std::visit([](const auto &concrete)
+                      { return concrete.IsInCategory(Event::EventCategory::Input); },
+                      event);
+}
+
+template <typename T>
+static void Write(std::ofstream &file, const T &value)
+{
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+// payload bytes after the index byte, indexed like QueuedEvent
+static constexpr std::size_t PAYLOAD_SIZES[std::variant_size_v<QueuedEvent>] = {
+    5, // KeyPressedEvent: key, repeat
+    4, // KeyReleasedEvent: key
+    4, // KeyRepeatEvent: key
+    4, // MouseButtonPressedEvent: button
+    4, // MouseButtonReleasedEvent: button
+    8, // MouseMovedEvent: x, y
+    8, // MouseScrolledEvent: x offset, y offset
+    8, // WindowResizedEvent: width, height
+    0, // WindowClosedEvent
+};
+
+// the switch in InputReplay::NextFrame relies on this order
+static_assert(std::is_same_v<std::variant_alternative_t<0, QueuedEvent>, KeyPressedEvent>);
+static_assert(std::is_same_v<std::variant_alternative_t<1, QueuedEvent>, KeyReleasedEvent>);
+static_assert(std::is_same_v<std::variant_alternative_t<2, QueuedEvent>, KeyRepeatEvent>);
+static_assert(std::is_same_v<std::variant_alternative_t<3, QueuedEvent>, MouseButtonPressedEvent>);
+static_assert(std::is_same_v<std::variant_alternative_t<4, QueuedEvent>, MouseButtonReleasedEvent>);
+static_assert(std::is_same_v<std::variant_alternative_t<5, QueuedEvent>, MouseMovedEvent>);
+static_assert(std::is_same_v<std::variant_alternative_t<6, QueuedEvent>, MouseScrolledEvent>);
+
+InputRecorder::InputRecorder(const std::string &path)
+    : m_File(path, std::ios::binary), m_Path(path), m_FrameCount(0)
+{
+    if (!m_File.is_open())
+    {
+        Logger::Critical("InputRecorder: could not open {}", path);
+        throw std::runtime_error("InputRecorder: could not open " + path);
+    }
+    m_File.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    Logger::Info("Recording input to {}", path);
+}
+
+InputRecorder::~InputRecorder()
+{
+    Logger::Info("Recorded {} frames of input to {}", m_FrameCount, m_Path);
+}
+
+void InputRecorder::RecordFrame(const std::vector<QueuedEvent> &events, float deltaTime)
+{
+    uint16_t count = 0;
+    for (const QueuedEvent &event : events)
+        count += IsInputEvent(event) ? 1 : 0;
+
+    Write(m_File, deltaTime);
+    Write(m_File, count);
+    for (const QueuedEvent &event : events)
+    {
+        if (!IsInputEvent(event))
+            continue;
+
+        Write(m_File, static_cast<uint8_t>(event.index()));
+        std::visit([this](const auto &concrete)
+                   {
+                       using T = std::decay_t<decltype(concrete)>;
+                       if constexpr (std::is_same_v<T, KeyPressedEvent>)
+                       {
+                           Write(m_File, static_cast<int32_t>(concrete.GetKeyCode()));
+                           Write(m_File, static_cast<uint8_t>(concrete.IsRepeat()));
+                       }
+                       else if constexpr (std::is_base_of_v<KeyEvent, T>)
+                           Write(m_File, static_cast<int32_t>(concrete.GetKeyCode()));
+                       else if constexpr (std::is_base_of_v<MouseButtonEvent, T>)
+                           Write(m_File, static_cast<int32_t>(concrete.GetButton()));
+                       else if constexpr (std::is_same_v<T, MouseMovedEvent>)
+                       {
+                           Write(m_File, concrete.GetX());
+                           Write(m_File, concrete.GetY());
+                       }
+                       else if constexpr (std::is_same_v<T, MouseScrolledEvent>)
+                       {
+                           Write(m_File, concrete.GetXOffset());
+                           Write(m_File, concrete.GetYOffset());
+                       } },
+                   event);
+    }
+    m_FrameCount++;
+}
+
+std::unique_ptr<InputRecorder> InputRecorder::FromCommandLine(int argc, char **argv)
+{
+    const char *path = PathFromCommandLine(argc, argv, "--record-input");
+    return path ? std::make_unique<InputRecorder>(path) : nullptr;
+}
+
+InputReplay::InputReplay(const std::string &path)
+    : m_Offset(sizeof(FILE_MAGIC)), m_FrameIndex(0), m_FrameCount(0)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        Logger::Critical("InputReplay: could not open {}", path);
+        throw std::runtime_error("InputReplay: could not open " + path);
+    }
+    m_Data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if (m_Data.size() < sizeof(FILE_MAGIC) || std::memcmp(m_Data.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    {
+        Logger::Critical("InputReplay: {} is not an input recording", path);
+        throw std::runtime_error("InputReplay: " + path + " is not an input recording");
+    }
+
+    // walk the whole file up front so NextFrame never reads past the end, a damaged tail is dropped
+    std::size_t offset = m_Offset;
+    while (offset + sizeof(float) + sizeof(uint16_t) <= m_Data.size())
+    {
+        uint16_t count;
+        std::memcpy(&count, &m_Data[offset + sizeof(float)], sizeof(count));
+        std::size_t next = offset + sizeof(float) + sizeof(uint16_t);
+        bool complete = true;
+        for (uint16_t i = 0; i < count && complete; i++)
+        {
+            complete = next < m_Data.size() && m_Data[next] < std::variant_size_v<QueuedEvent>;
+            if (complete)
+                next += 1 + PAYLOAD_SIZES[m_Data[next]];
+        }
+        if (!complete || next > m_Data.size())
+            break;
+        offset = next;
+        m_FrameCount++;
+    }
+    m_Data.resize(offset); // drop a partial or corrupt tail
+
+    Logger::Info("Replaying {} frames of input from {}", m_FrameCount, path);
+}
+
+bool InputReplay::NextFrame(EventQueue &queue, float &deltaTime)
+{
+    if (m_FrameIndex >= m_FrameCount)
+        return false;
+
+    auto read = [this](auto &value)
+    {
+        std::memcpy(&value, &m_Data[m_Offset], sizeof(value));
+        m_Offset += sizeof(value);
+    };
+
+    uint16_t count;
+    read(deltaTime);
+    read(count);
+
+    queue.DiscardInput();
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint8_t index;
+        int32_t code;
+        float x, y;
+        read(index);
+        switch (index)
+        {
+        case 0:
+        {
+            uint8_t repeat;
+            read(code);
+            read(repeat);
+            queue.Push(KeyPressedEvent(code, repeat != 0));
+            break;
+        }
+        case 1:
+            read(code);
+            queue.Push(KeyReleasedEvent(code));
+            break;
+        case 2:
+            read(code);
+            queue.Push(KeyRepeatEvent(code));
+            break;
+        case 3:
+            read(code);
+            queue.Push(MouseButtonPressedEvent(code));
+            break;
+        case 4:
+            read(code);
+            queue.Push(MouseButtonReleasedEvent(code));
+            break;
+        case 5:
+            read(x);
+            read(y);
+            queue.Push(MouseMovedEvent(x, y));
+            break;
+        case 6:
+            read(x);
+            read(y);
+            queue.Push(MouseScrolledEvent(x, y));
+            break;
+        default:
+            // window events are never recorded, skip anything else by its size
+            m_Offset += PAYLOAD_SIZES[index];
+            break;
+        }
+    }
+
+    m_FrameIndex++;
+    return true;
+}
+
+std::unique_ptr<InputReplay> InputReplay::FromCommandLine(int argc, char **argv)
+{
+    const char *path = PathFromCommandLine(argc, argv, "--replay-input");
+    return path ? std::make_unique<InputReplay>(path) : nullptr;
+}
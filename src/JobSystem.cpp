@@ -0,0 +1,240 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include "Logger.hpp"
+#include "Profiler.hpp"
+
+// queue of the calling thread, workers set their own, every other thread uses the main queue
+static thread_local uint32_t t_ThreadIndex = 0;
+
+bool JobSystem::JobQueue::Push(const Job &job)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tail - head >= QUEUE_CAPACITY)
+        return false;
+    jobs[tail++ % QUEUE_CAPACITY] = job;
+    return true;
+}
+
+bool JobSystem::JobQueue::Pop(Job &job)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tail == head)
+        return false;
+    job = jobs[--tail % QUEUE_CAPACITY];
+    return true;
+}
+
+bool JobSystem::JobQueue::Steal(Job &job)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tail == head)
+        return false;
+    job = jobs[head++ % QUEUE_CAPACITY];
+    return true;
+}
+
+JobSystem::JobSystem(int workerCount)
+    : m_BackgroundQueue(std::make_unique<JobQueue>()), m_QueuedJobs(0), m_Running(true), m_LastFrameNs(Profiler::Now())
+{
+    if (workerCount < 0)
+        workerCount = static_cast<int>(std::max(std::thread::hardware_concurrency(), 2u)) - 1;
+    workerCount = std::min(workerCount, static_cast<int>(MAX_WORKERS));
+
+    uint32_t threadCount = static_cast<uint32_t>(workerCount) + 1;
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        m_Queues.push_back(std::make_unique<JobQueue>());
+        m_Counters.push_back(std::make_unique<ThreadCounters>());
+        m_ThreadNames.push_back(i == 0 ? "Main" : "Job Worker " + std::to_string(i));
+    }
+    m_ThreadStats.assign(threadCount, JobThreadStats{0.0f, 0, 0});
+    m_LastBusyNs.assign(threadCount, 0);
+
+    m_Workers.reserve(workerCount);
+    for (uint32_t i = 1; i < threadCount; i++)
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+
+    Logger::Info("JobSystem: {} worker threads", workerCount);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Running.store(false);
+    }
+    m_WakeCondition.notify_all();
+    for (auto &worker : m_Workers)
+        worker.join();
+
+    // whatever is left was submitted without a Wait, finish it here so no counter is left hanging
+    Job job;
+    for (auto &queue : m_Queues)
+        while (queue->Pop(job))
+            Execute(job, 0);
+    while (m_BackgroundQueue->Steal(job))
+        Execute(job, 0);
+}
+
+void JobSystem::Submit(JobFunction function, void *data, JobCounter &counter, const char *name, uint32_t begin,
+                       uint32_t end)
+{
+    counter.m_Pending.fetch_add(1, std::memory_order_relaxed);
+    Job job{function, data, begin, end, &counter, name};
+    if (m_Workers.empty() || !m_Queues[t_ThreadIndex]->Push(job))
+    {
+        Execute(job, t_ThreadIndex);
+        return;
+    }
+    WakeWorkers(1);
+}
+
+void JobSystem::SubmitBackground(JobFunction function, void *data, JobCounter &counter, const char *name)
+{
+    counter.m_Pending.fetch_add(1, std::memory_order_relaxed);
+    Job job{function, data, 0, 1, &counter, name};
+    if (m_Workers.empty() || !m_BackgroundQueue->Push(job))
+    {
+        Execute(job, t_ThreadIndex);
+        return;
+    }
+    WakeWorkers(1);
+}
+
+void JobSystem::SubmitRange(JobFunction function, void *data, uint32_t count, uint32_t grainSize, JobCounter &counter,
+                            const char *name)
+{
+    uint32_t chunks = (count + grainSize - 1) / grainSize;
+    counter.m_Pending.fetch_add(chunks, std::memory_order_relaxed);
+
+    // the first chunk is kept for the calling thread, it would otherwise just wait
+    JobQueue &queue = *m_Queues[t_ThreadIndex];
+    uint32_t queued = 0;
+    for (uint32_t chunk = 1; chunk < chunks; chunk++)
+    {
+        uint32_t begin = chunk * grainSize;
+        Job job{function, data, begin, std::min(begin + grainSize, count), &counter, name};
+        if (queue.Push(job))
+            queued++;
+        else
+            Execute(job, t_ThreadIndex);
+    }
+    WakeWorkers(queued);
+
+    Execute(Job{function, data, 0, std::min(grainSize, count), &counter, name}, t_ThreadIndex);
+}
+
+void JobSystem::Wait(JobCounter &counter)
+{
+    while (!counter.IsDone())
+        if (!RunOne(t_ThreadIndex, false))
+            std::this_thread::yield();
+}
+
+void JobSystem::WakeWorkers(uint32_t jobCount)
+{
+    if (jobCount == 0)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_QueuedJobs.fetch_add(static_cast<int32_t>(jobCount));
+    }
+    if (jobCount == 1)
+        m_WakeCondition.notify_one();
+    else
+        m_WakeCondition.notify_all();
+}
+
+bool JobSystem::RunOne(uint32_t index, bool allowBackground)
+{
+    Job job;
+    bool found = m_Queues[index]->Pop(job);
+    bool stolen = false;
+    // start with the next queue over so thieves spread out instead of all hitting queue 0
+    for (std::size_t offset = 1; !found && offset < m_Queues.size(); offset++)
+        found = stolen = m_Queues[(index + offset) % m_Queues.size()]->Steal(job);
+    // oldest background job first, only once there is no frame work left
+    if (!found && allowBackground)
+        found = m_BackgroundQueue->Steal(job);
+    if (!found)
+        return false;
+
+    m_QueuedJobs.fetch_sub(1);
+    if (stolen)
+        m_Counters[index]->steals.fetch_add(1, std::memory_order_relaxed);
+    Execute(job, index);
+    return true;
+}
+
+void JobSystem::Execute(const Job &job, uint32_t index)
+{
+    uint64_t start = Profiler::Now();
+    {
+        PROFILE_SCOPE(job.name);
+        job.function(job.data, job.begin, job.end);
+    }
+    ThreadCounters &counters = *m_Counters[index];
+    counters.busyNs.fetch_add(Profiler::Now() - start, std::memory_order_relaxed);
+    counters.jobs.fetch_add(1, std::memory_order_relaxed);
+    job.counter->m_Pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::WorkerLoop(uint32_t index)
+{
+    t_ThreadIndex = index;
+    Profiler::SetThreadName(m_ThreadNames[index].c_str());
+
+    while (m_Running.load())
+    {
+        if (RunOne(index, true))
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+        m_WakeCondition.wait(lock, [this]()
+                             { return m_QueuedJobs.load() > 0 || !m_Running.load(); });
+    }
+}
+
+void JobSystem::EndFrame()
+{
+    uint64_t now = Profiler::Now();
+    double frameNs = static_cast<double>(std::max<uint64_t>(now - m_LastFrameNs, 1));
+    m_LastFrameNs = now;
+
+    for (std::size_t i = 0; i < m_Counters.size(); i++)
+    {
+        ThreadCounters &counters = *m_Counters[i];
+        uint64_t busy = counters.busyNs.load(std::memory_order_relaxed);
+        JobThreadStats &stats = m_ThreadStats[i];
+        stats.utilization = static_cast<float>(std::min((busy - m_LastBusyNs[i]) / frameNs, 1.0));
+        stats.jobs = counters.jobs.exchange(0, std::memory_order_relaxed);
+        stats.steals = counters.steals.exchange(0, std::memory_order_relaxed);
+        m_LastBusyNs[i] = busy;
+    }
+}
+
+std::unique_ptr<JobSystem> JobSystem::FromCommandLine(int argc, char **argv)
+{
+    int workerCount = -1;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--job-workers") != 0)
+            continue;
+
+        // digits only, at most MAX_WORKERS
+        const char *text = argv[i + 1];
+        char *end = nullptr;
+        errno = 0;
+        unsigned long value = std::strtoul(text, &end, 10);
+        if (!std::isdigit(static_cast<unsigned char>(text[0])) || errno != 0 || *end != '\0' || value > MAX_WORKERS)
+            Logger::Warn("--job-workers: '{}' is not a worker count between 0 and {}, using the default", text,
+                         MAX_WORKERS);
+        else
+            workerCount = static_cast<int>(value);
+    }
+    return std::make_unique<JobSystem>(workerCount);
+}
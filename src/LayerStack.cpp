@@ -1,52 +1,148 @@
 #include "LayerStack.hpp"
+#include "AllocationTracker.hpp"
+#include "Profiler.hpp"
+
+// smoothing for the displayed per-layer times, roughly the last 20 frames
+static constexpr float TIMING_SMOOTHING = 0.05f;
+
+static float ElapsedMs(uint64_t startNs)
+{
+    return static_cast<float>(Profiler::Now() - startNs) / 1.0e6f;
+}
 
 LayerStack::~LayerStack()
 {
-    for (Layer *layer : m_Layers)
+    for (const auto &layer : m_Layers)
     {
+        PROFILE_SCOPE_DETAIL("OnDetach", layer->m_ProfileName);
         layer->OnDetach();
-        delete layer;
     }
+    m_Layers.clear();
 }
 
-void LayerStack::PushLayer(Layer *layer)
+Layer *LayerStack::PushLayer(std::unique_ptr<Layer> layer)
 {
-    m_Layers.emplace(m_Layers.begin() + m_LayerInsertIndex, layer);
+    Layer *pushed = layer.get();
+    pushed->m_ProfileName = Profiler::Intern(pushed->GetName());
+    m_Layers.emplace(m_Layers.begin() + m_LayerInsertIndex, std::move(layer));
     m_LayerInsertIndex++;
-    layer->OnAttach();
+    PROFILE_SCOPE_DETAIL("OnAttach", pushed->m_ProfileName);
+    pushed->OnAttach();
+    RebuildEventTable();
+    RebuildActiveLayers();
+    return pushed;
+}
+
+Layer *LayerStack::PushOverlay(std::unique_ptr<Layer> overlay)
+{
+    Layer *pushed = overlay.get();
+    pushed->m_ProfileName = Profiler::Intern(pushed->GetName());
+    m_Layers.emplace_back(std::move(overlay));
+    PROFILE_SCOPE_DETAIL("OnAttach", pushed->m_ProfileName);
+    pushed->OnAttach();
+    RebuildEventTable();
+    RebuildActiveLayers();
+    return pushed;
+}
+
+std::unique_ptr<Layer> LayerStack::PopLayer(Layer *layer)
+{
+    auto it = std::find_if(m_Layers.begin(), m_Layers.begin() + m_LayerInsertIndex,
+                           [layer](const std::unique_ptr<Layer> &owned)
+                           { return owned.get() == layer; });
+    if (it == m_Layers.begin() + m_LayerInsertIndex)
+        return nullptr;
+
+    PROFILE_SCOPE_DETAIL("OnDetach", layer->m_ProfileName);
+    layer->OnDetach();
+    std::unique_ptr<Layer> popped = std::move(*it);
+    m_Layers.erase(it);
+    m_LayerInsertIndex--;
+    RebuildEventTable();
+    RebuildActiveLayers();
+    return popped;
+}
+
+std::unique_ptr<Layer> LayerStack::PopOverlay(Layer *overlay)
+{
+    auto it = std::find_if(m_Layers.begin() + m_LayerInsertIndex, m_Layers.end(),
+                           [overlay](const std::unique_ptr<Layer> &owned)
+                           { return owned.get() == overlay; });
+    if (it == m_Layers.end())
+        return nullptr;
+
+    PROFILE_SCOPE_DETAIL("OnDetach", overlay->m_ProfileName);
+    overlay->OnDetach();
+    std::unique_ptr<Layer> popped = std::move(*it);
+    m_Layers.erase(it);
+    RebuildEventTable();
+    RebuildActiveLayers();
+    return popped;
 }
 
-void LayerStack::PushOverlay(Layer *overlay)
+void LayerStack::SetVisibility(Layer *layer, bool visible)
 {
-    m_Layers.emplace_back(overlay);
-    overlay->OnAttach();
+    if (layer->m_Visible == visible)
+        return;
+    layer->m_Visible = visible;
+    layer->m_Timing = LayerTiming();
+    m_ActiveLayersDirty = true;
 }
 
-void LayerStack::PopLayer(Layer *layer)
+void LayerStack::UpdateLayers(float deltaTime)
 {
-    auto it = std::find(m_Layers.begin(), m_Layers.begin() + m_LayerInsertIndex, layer);
-    if (it != m_Layers.begin() + m_LayerInsertIndex)
+    if (m_ActiveLayersDirty)
+        RebuildActiveLayers();
+
+    for (Layer *layer : m_ActiveLayers)
     {
-        layer->OnDetach();
-        m_Layers.erase(it);
-        m_LayerInsertIndex--;
+        PROFILE_SCOPE_DETAIL("OnUpdate", layer->m_ProfileName);
+        AllocationScope allocationScope(AllocTag::Update);
+        uint64_t start = Profiler::Now();
+        layer->OnUpdate(deltaTime);
+
+        LayerTiming &timing = layer->m_Timing;
+        timing.updateMs = ElapsedMs(start);
+        timing.averageUpdateMs += (timing.updateMs - timing.averageUpdateMs) * TIMING_SMOOTHING;
     }
 }
 
-void LayerStack::PopOverlay(Layer *overlay)
+void LayerStack::RenderLayers()
 {
-    auto it = std::find(m_Layers.begin() + m_LayerInsertIndex, m_Layers.end(), overlay);
-    if (it != m_Layers.end())
+    for (Layer *layer : m_ActiveLayers)
     {
-        overlay->OnDetach();
-        m_Layers.erase(it);
+        PROFILE_SCOPE_DETAIL("OnRender", layer->m_ProfileName);
+        AllocationScope allocationScope(AllocTag::Render);
+        uint64_t start = Profiler::Now();
+        layer->OnRender();
+
+        LayerTiming &timing = layer->m_Timing;
+        timing.renderMs = ElapsedMs(start);
+        timing.averageRenderMs += (timing.renderMs - timing.averageRenderMs) * TIMING_SMOOTHING;
     }
 }
 
 Layer *LayerStack::FindLayerByName(const std::string &name) const
 {
-    for (Layer *layer : m_Layers)
+    for (const auto &layer : m_Layers)
         if (layer->GetName() == name)
-            return layer;
+            return layer.get();
     return nullptr;
-}
\ No newline at end of file
+}
+
+void LayerStack::RebuildEventTable()
+{
+    // topmost first, so overlays get the first chance to handle an event
+    m_EventTable.Clear();
+    for (auto it = m_Layers.rbegin(); it != m_Layers.rend(); ++it)
+        (*it)->SubscribeEvents(m_EventTable);
+}
+
+void LayerStack::RebuildActiveLayers()
+{
+    m_ActiveLayers.clear();
+    for (const auto &layer : m_Layers)
+        if (layer->IsVisible())
+            m_ActiveLayers.push_back(layer.get());
+    m_ActiveLayersDirty = false;
+}
@@ -0,0 +1,264 @@
+#include "LightGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include "GLCall.hpp"
+#include "Logger.hpp"
+
+enum LightGridBuffer
+{
+    LIGHT_DATA = 0,
+    CLUSTER_RANGES,
+    LIGHT_INDICES
+};
+
+// below this many visible lights a single slice job is faster than splitting the work
+static constexpr std::size_t PARALLEL_LIGHT_THRESHOLD = 64;
+// lights per culling job, a light's bounds are only a handful of matrix products
+static constexpr uint32_t CULL_GRAIN_SIZE = 64;
+
+LightGrid::LightGrid(uint32_t tileSize, uint32_t depthSlices)
+    : m_TileSize(tileSize),
+      m_DepthSlices(std::max(depthSlices, 1u)),
+      m_TileCountX(0),
+      m_TileCountY(0),
+      m_Width(0),
+      m_Height(0),
+      m_NearPlane(0.1f),
+      m_FarPlane(1000.0f),
+      m_SliceScale(0.0f),
+      m_SliceBias(0.0f),
+      m_WorkerCount(1)
+{
+    const GLenum formats[3] = {GL_RGBA32F, GL_RG32UI, GL_R32UI};
+
+    GL_CALL(Buffer, glGenBuffers(3, m_Buffers));
+    GL_CALL(Texture, glGenTextures(3, m_Textures));
+    for (int i = 0; i < 3; i++)
+    {
+        GL_CALL(Bind, glBindBuffer(GL_TEXTURE_BUFFER, m_Buffers[i]));
+        GL_CALL(Buffer, glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_STREAM_DRAW));
+        GL_CALL(Bind, glBindTexture(GL_TEXTURE_BUFFER, m_Textures[i]));
+        GL_CALL(Texture, glTexBuffer(GL_TEXTURE_BUFFER, formats[i], m_Buffers[i]));
+    }
+    GL_CALL(Bind, glBindTexture(GL_TEXTURE_BUFFER, 0));
+    GL_CALL(Bind, glBindBuffer(GL_TEXTURE_BUFFER, 0));
+
+    SetDepthRange(m_NearPlane, m_FarPlane);
+}
+
+LightGrid::~LightGrid()
+{
+    GL_CALL(Texture, glDeleteTextures(3, m_Textures));
+    GL_CALL(Buffer, glDeleteBuffers(3, m_Buffers));
+}
+
+void LightGrid::SetDepthRange(float nearPlane, float farPlane)
+{
+    m_NearPlane = nearPlane;
+    m_FarPlane = farPlane;
+
+    // exponential slices keep clusters roughly cube shaped in view space
+    m_SliceScale = m_DepthSlices / std::log(farPlane / nearPlane);
+    m_SliceBias = -std::log(nearPlane) * m_SliceScale;
+}
+
+void LightGrid::Build(const PointLight *lights, std::size_t lightCount, const glm::mat4 &view,
+                      const glm::mat4 &projection, int width, int height, FrameArena &arena, JobSystem &jobs)
+{
+    m_Width = width;
+    m_Height = height;
+    m_TileCountX = (width + m_TileSize - 1) / m_TileSize;
+    m_TileCountY = (height + m_TileSize - 1) / m_TileSize;
+    uint32_t clusterCount = m_TileCountX * m_TileCountY * m_DepthSlices;
+
+    m_LightData.clear();
+    m_ClusterRanges.assign(clusterCount * 2, 0);
+
+    // culling results only live for this build, keep them off the heap
+    FrameVector<ClusterBounds> allBounds(lightCount, ClusterBounds(), FrameAllocator<ClusterBounds>(arena));
+    FrameVector<uint8_t> visible(lightCount, 0, FrameAllocator<uint8_t>(arena));
+    FrameVector<ClusterBounds> lightBounds{FrameAllocator<ClusterBounds>(arena)};
+    lightBounds.reserve(lightCount);
+
+    // frustum test and bounds per light, every job writes only its own range
+    jobs.ParallelFor(static_cast<uint32_t>(lightCount), CULL_GRAIN_SIZE, [&](uint32_t begin, uint32_t end)
+                     {
+                         for (uint32_t i = begin; i < end; i++)
+                             visible[i] = GetClusterBounds(lights[i], view, projection, allBounds[i]); },
+                     "CullLights");
+
+    // compacted in order so light indices only refer to visible lights
+    for (std::size_t i = 0; i < lightCount; i++)
+    {
+        if (!visible[i])
+            continue;
+
+        const PointLight &light = lights[i];
+        m_LightData.push_back(glm::vec4(light.position, light.radius));
+        m_LightData.push_back(glm::vec4(light.color, light.intensity));
+        lightBounds.push_back(allBounds[i]);
+    }
+
+    uint32_t workerCount = 1;
+    if (m_DepthSlices > 1 && lightBounds.size() >= PARALLEL_LIGHT_THRESHOLD)
+        workerCount = std::min(m_DepthSlices, jobs.GetThreadCount());
+    m_WorkerCount = workerCount;
+
+    FrameVector<FrameVector<uint32_t>> workerIndices{FrameAllocator<FrameVector<uint32_t>>(arena)};
+    workerIndices.reserve(workerCount);
+    for (uint32_t worker = 0; worker < workerCount; worker++)
+        workerIndices.emplace_back(FrameAllocator<uint32_t>(arena));
+
+    auto sliceBegin = [this, workerCount](uint32_t worker)
+    {
+        return m_DepthSlices * worker / workerCount;
+    };
+
+    // jobs write disjoint cluster ranges and their own index lists
+    jobs.ParallelFor(workerCount, 1, [&](uint32_t begin, uint32_t end)
+                     {
+                         for (uint32_t worker = begin; worker < end; worker++)
+                             AssignSlices(lightBounds, sliceBegin(worker), sliceBegin(worker + 1), workerIndices[worker]); },
+                     "AssignSlices");
+
+    // stitch per-worker lists together, shifting their local offsets
+    uint32_t tilesPerSlice = m_TileCountX * m_TileCountY;
+    m_LightIndices.clear();
+    for (uint32_t worker = 0; worker < workerCount; worker++)
+    {
+        uint32_t base = static_cast<uint32_t>(m_LightIndices.size());
+        for (uint32_t cluster = sliceBegin(worker) * tilesPerSlice; cluster < sliceBegin(worker + 1) * tilesPerSlice; cluster++)
+            m_ClusterRanges[cluster * 2] += base;
+
+        const auto &indices = workerIndices[worker];
+        m_LightIndices.insert(m_LightIndices.end(), indices.begin(), indices.end());
+    }
+
+    Upload();
+}
+
+void LightGrid::AssignSlices(const FrameVector<ClusterBounds> &lightBounds, uint32_t firstSlice, uint32_t lastSlice,
+                             FrameVector<uint32_t> &indices)
+{
+    uint32_t tilesPerSlice = m_TileCountX * m_TileCountY;
+
+    auto forEachCluster = [&](auto &&func)
+    {
+        for (uint32_t lightIndex = 0; lightIndex < lightBounds.size(); lightIndex++)
+        {
+            const ClusterBounds &bounds = lightBounds[lightIndex];
+            int begin = std::max<int>(bounds.firstSlice, firstSlice);
+            int end = std::min<int>(bounds.lastSlice, lastSlice - 1);
+
+            for (int slice = begin; slice <= end; slice++)
+                for (int y = bounds.tiles.y; y <= bounds.tiles.w; y++)
+                    for (int x = bounds.tiles.x; x <= bounds.tiles.z; x++)
+                        func((slice * m_TileCountY + y) * m_TileCountX + x, lightIndex);
+        }
+    };
+
+    // pass 1: count lights per cluster
+    forEachCluster([this](uint32_t cluster, uint32_t)
+                   { m_ClusterRanges[cluster * 2 + 1]++; });
+
+    // prefix sum into offsets, then reuse count as the write cursor
+    uint32_t offset = 0;
+    for (uint32_t cluster = firstSlice * tilesPerSlice; cluster < lastSlice * tilesPerSlice; cluster++)
+    {
+        m_ClusterRanges[cluster * 2] = offset;
+        offset += m_ClusterRanges[cluster * 2 + 1];
+        m_ClusterRanges[cluster * 2 + 1] = 0;
+    }
+    indices.resize(offset);
+
+    // pass 2: scatter visible light indices
+    forEachCluster([this, &indices](uint32_t cluster, uint32_t lightIndex)
+                   { indices[m_ClusterRanges[cluster * 2] + m_ClusterRanges[cluster * 2 + 1]++] = lightIndex; });
+}
+
+int LightGrid::GetSlice(float viewDepth) const
+{
+    if (m_DepthSlices == 1 || viewDepth <= m_NearPlane)
+        return 0;
+
+    int slice = static_cast<int>(std::log(viewDepth) * m_SliceScale + m_SliceBias);
+    return std::min(slice, static_cast<int>(m_DepthSlices) - 1);
+}
+
+bool LightGrid::GetClusterBounds(const PointLight &light, const glm::mat4 &view, const glm::mat4 &projection,
+                                 ClusterBounds &bounds) const
+{
+    glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0f));
+
+    // fully behind the camera or beyond the far plane
+    if (center.z - light.radius > 0.0f || -center.z - light.radius > m_FarPlane)
+        return false;
+
+    bounds.firstSlice = GetSlice(-center.z - light.radius);
+    bounds.lastSlice = GetSlice(-center.z + light.radius);
+
+    glm::vec2 minNdc(1.0f), maxNdc(-1.0f);
+    if (center.z + light.radius > -0.01f)
+    {
+        // sphere crosses the camera plane, projecting the box is unreliable
+        minNdc = glm::vec2(-1.0f);
+        maxNdc = glm::vec2(1.0f);
+    }
+    else
+    {
+        // conservative screen rectangle from the 8 corners of the view space bounding box
+        for (int corner = 0; corner < 8; corner++)
+        {
+            glm::vec3 offset((corner & 1) ? light.radius : -light.radius,
+                             (corner & 2) ? light.radius : -light.radius,
+                             (corner & 4) ? light.radius : -light.radius);
+            glm::vec4 clip = projection * glm::vec4(center + offset, 1.0f);
+            glm::vec2 ndc = glm::vec2(clip) / clip.w;
+            minNdc = glm::min(minNdc, ndc);
+            maxNdc = glm::max(maxNdc, ndc);
+        }
+    }
+
+    if (maxNdc.x < -1.0f || maxNdc.y < -1.0f || minNdc.x > 1.0f || minNdc.y > 1.0f)
+        return false;
+
+    minNdc = glm::clamp(minNdc, -1.0f, 1.0f);
+    maxNdc = glm::clamp(maxNdc, -1.0f, 1.0f);
+
+    auto toTile = [this](float ndc, int size, uint32_t tileCount)
+    {
+        int pixel = static_cast<int>((ndc * 0.5f + 0.5f) * size);
+        return std::min(static_cast<int>(tileCount) - 1, std::max(0, pixel / static_cast<int>(m_TileSize)));
+    };
+
+    bounds.tiles = glm::ivec4(toTile(minNdc.x, m_Width, m_TileCountX), toTile(minNdc.y, m_Height, m_TileCountY),
+                              toTile(maxNdc.x, m_Width, m_TileCountX), toTile(maxNdc.y, m_Height, m_TileCountY));
+    return true;
+}
+
+void LightGrid::Upload()
+{
+    auto upload = [this](LightGridBuffer buffer, const void *data, std::size_t size)
+    {
+        GL_CALL(Bind, glBindBuffer(GL_TEXTURE_BUFFER, m_Buffers[buffer]));
+        // orphan, the previous frame may still be reading the old contents
+        GL_CALL(Buffer, glBufferData(GL_TEXTURE_BUFFER, std::max<std::size_t>(size, 16), nullptr, GL_STREAM_DRAW));
+        if (size)
+            GL_CALL(Buffer, glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data));
+    };
+
+    upload(LIGHT_DATA, m_LightData.data(), m_LightData.size() * sizeof(glm::vec4));
+    upload(CLUSTER_RANGES, m_ClusterRanges.data(), m_ClusterRanges.size() * sizeof(uint32_t));
+    upload(LIGHT_INDICES, m_LightIndices.data(), m_LightIndices.size() * sizeof(uint32_t));
+    GL_CALL(Bind, glBindBuffer(GL_TEXTURE_BUFFER, 0));
+}
+
+void LightGrid::BindTextures(GLenum firstUnit) const
+{
+    for (int i = 0; i < 3; i++)
+    {
+        GL_CALL(Bind, glActiveTexture(firstUnit + i));
+        GL_CALL(Bind, glBindTexture(GL_TEXTURE_BUFFER, m_Textures[i]));
+    }
+    GL_CALL(Bind, glActiveTexture(GL_TEXTURE0));
+}
@@ -0,0 +1,67 @@
+#include "LogQueue.hpp"
+#include <algorithm>
+#include <cstring>
+
+LogQueue::LogQueue(std::size_t capacity)
+    : m_Mask(0),
+      m_EnqueuePos(0),
+      m_DequeuePos(0)
+{
+    std::size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+    m_Mask = size - 1;
+
+    m_Slots = std::make_unique<Slot[]>(size);
+    for (std::size_t i = 0; i < size; i++)
+        m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool LogQueue::TryPush(spdlog::level::level_enum level, spdlog::log_clock::time_point time, const char *text,
+                       std::size_t length)
+{
+    Slot *slot = nullptr;
+    std::size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        slot = &m_Slots[pos & m_Mask];
+        std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (diff == 0)
+        {
+            // slot is free for this position, claim it
+            if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return false; // the writer hasn't consumed this slot yet, ring is full
+        else
+            pos = m_EnqueuePos.load(std::memory_order_relaxed);
+    }
+
+    LogRecord &record = slot->record;
+    record.time = time;
+    record.level = level;
+    record.length = static_cast<uint32_t>(std::min(length, LogRecord::TEXT_CAPACITY));
+    std::memcpy(record.text, text, record.length);
+    if (length > LogRecord::TEXT_CAPACITY)
+        std::memcpy(record.text + LogRecord::TEXT_CAPACITY - 3, "...", 3);
+
+    // publish to the consumer
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogQueue::TryPop(LogRecord &record)
+{
+    Slot &slot = m_Slots[m_DequeuePos & m_Mask];
+    if (slot.sequence.load(std::memory_order_acquire) != m_DequeuePos + 1)
+        return false;
+
+    record = slot.record;
+    // hand the slot back to producers one lap ahead
+    slot.sequence.store(m_DequeuePos + m_Mask + 1, std::memory_order_release);
+    m_DequeuePos++;
+    return true;
+}
@@ -1,4 +1,8 @@
 #include "Logger.hpp"
+#include "Profiler.hpp"
+
+// writer sleeps this long when the ring is empty, producers never have to wake it on the hot path
+static constexpr auto WRITER_IDLE_WAIT = std::chrono::milliseconds(2);
 
 Logger &Logger::Instance()
 {
@@ -8,6 +12,11 @@ Logger &Logger::Instance()
 
 // Private constructor
 Logger::Logger()
+    : m_Async(false),
+      m_Running(false),
+      m_Pending(0),
+      m_Dropped(0),
+      m_Policy(LogOverflowPolicy::Drop)
 {
     auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
     m_Logger = std::make_shared<spdlog::logger>("console_logger", console_sink);
@@ -17,4 +26,115 @@ Logger::Logger()
     m_Logger->set_pattern("%^[%r] [%l]%$ %v");
 
     spdlog::info("Logger initialized successfully!");
-}
\ No newline at end of file
+}
+
+Logger::~Logger()
+{
+    StopWriter();
+}
+
+void Logger::StartAsync(LogOverflowPolicy policy, std::size_t capacity)
+{
+    Logger &logger = Instance();
+    if (logger.m_Async.load())
+        return;
+
+    logger.m_Policy = policy;
+    logger.m_Queue = std::make_unique<LogQueue>(capacity);
+    logger.m_Running.store(true);
+    logger.m_Writer = std::thread([&logger]()
+                                  { logger.WriterLoop(); });
+    logger.m_Async.store(true, std::memory_order_release);
+
+    Debug("Logger: async, {} records, {} on overflow", logger.m_Queue->GetCapacity(),
+          policy == LogOverflowPolicy::Drop ? "drop" : "block");
+}
+
+void Logger::StopAsync()
+{
+    Instance().StopWriter();
+}
+
+void Logger::Flush()
+{
+    Logger &logger = Instance();
+    if (logger.m_Async.load(std::memory_order_acquire))
+    {
+        logger.m_Wake.notify_one();
+        while (logger.m_Pending.load(std::memory_order_acquire) > 0)
+            std::this_thread::yield();
+    }
+    logger.m_Logger->flush();
+}
+
+void Logger::StopWriter()
+{
+    if (!m_Async.exchange(false))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Running.store(false);
+    }
+    m_Wake.notify_one();
+    m_Writer.join();
+    m_Logger->flush();
+}
+
+void Logger::Enqueue(spdlog::level::level_enum level, const char *text, std::size_t length)
+{
+    auto now = spdlog::log_clock::now();
+    // counted before the push so Flush never sees 0 while a record is in flight
+    m_Pending.fetch_add(1, std::memory_order_relaxed);
+    while (!m_Queue->TryPush(level, now, text, length))
+    {
+        if (m_Policy == LogOverflowPolicy::Drop && level < spdlog::level::warn)
+        {
+            m_Pending.fetch_sub(1, std::memory_order_relaxed);
+            m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_Wake.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+void Logger::WriterLoop()
+{
+    Profiler::SetThreadName("Logger");
+    AllocationScope allocationScope(AllocTag::Logging);
+
+    LogRecord record;
+    uint64_t reportedDrops = 0;
+    for (;;)
+    {
+        bool running = m_Running.load();
+        while (m_Queue->TryPop(record))
+        {
+            Write(record);
+            m_Pending.fetch_sub(1, std::memory_order_release);
+        }
+
+        uint64_t dropped = m_Dropped.load(std::memory_order_relaxed);
+        if (dropped != reportedDrops)
+        {
+            m_Logger->warn("Logger dropped {} messages (ring full)", dropped - reportedDrops);
+            reportedDrops = dropped;
+        }
+
+        // the ring was drained after m_Running went false, nothing can be left behind
+        if (!running)
+            break;
+
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+        m_Wake.wait_for(lock, WRITER_IDLE_WAIT, [this]()
+                        { return !m_Running.load(); });
+    }
+}
+
+void Logger::Write(const LogRecord &record)
+{
+    // keep the caller's timestamp, not the time the writer got to it
+    m_Logger->log(record.time, spdlog::source_loc{}, record.level,
+                  spdlog::string_view_t(record.text, record.length));
+}
@@ -0,0 +1,153 @@
+#include "Profiler.hpp"
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include "Logger.hpp"
+
+std::atomic<bool> Profiler::s_Enabled{true};
+
+/**
+ * Single producer ring, written only by its owning thread
+ * m_Head is published with release order after the event is written, so a reader that
+ * acquires it sees complete events. Slots the writer may have reused while the reader was
+ * copying are detected by re-reading m_Head and dropped.
+ */
+struct Profiler::ThreadBuffer
+{
+    uint32_t threadID;
+    std::atomic<const char *> threadName{nullptr};
+    std::atomic<uint64_t> head{0};
+    std::vector<TraceEvent> events;
+
+    explicit ThreadBuffer(uint32_t id) : threadID(id), events(TRACE_BUFFER_CAPACITY) {}
+};
+
+// every buffer ever created, buffers outlive their threads so late dumps still see them
+static std::mutex s_BuffersMutex;
+static std::vector<std::unique_ptr<Profiler::ThreadBuffer>> s_Buffers;
+
+static const auto s_Epoch = std::chrono::steady_clock::now();
+
+Profiler::ThreadBuffer &Profiler::GetThreadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(s_BuffersMutex);
+        s_Buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(s_Buffers.size() + 1)));
+        buffer = s_Buffers.back().get();
+    }
+    return *buffer;
+}
+
+uint64_t Profiler::Now()
+{
+    auto elapsed = std::chrono::steady_clock::now() - s_Epoch;
+    // +1 so a valid timestamp is never 0 (ProfileScope uses 0 for "disabled")
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) + 1;
+}
+
+void Profiler::Record(const char *name, const char *detail, uint64_t startNs, uint64_t endNs)
+{
+    ThreadBuffer &buffer = GetThreadBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head % TRACE_BUFFER_CAPACITY] = {name, detail, startNs, endNs - startNs};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const char *name)
+{
+    // the buffer outlives its thread, so the name must too
+    GetThreadBuffer().threadName.store(Intern(name), std::memory_order_release);
+}
+
+const char *Profiler::Intern(const std::string &text)
+{
+    // node based, c_str() pointers stay put while the set grows
+    static std::mutex s_InternMutex;
+    static std::unordered_set<std::string> s_Interned;
+    std::lock_guard<std::mutex> lock(s_InternMutex);
+    return s_Interned.insert(text).first->c_str();
+}
+
+static void WriteJsonString(std::ofstream &file, const char *text)
+{
+    file << '"';
+    for (const char *c = text; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+            file << '\\';
+        file << *c;
+    }
+    file << '"';
+}
+
+bool Profiler::WriteChromeTrace(const std::string &path)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        Logger::Warn("Profiler: could not open {}", path);
+        return false;
+    }
+
+    std::vector<TraceEvent> snapshot;
+    snapshot.reserve(TRACE_BUFFER_CAPACITY);
+    std::size_t eventCount = 0;
+    bool first = true;
+
+    // buffers are never freed, so the list is copied and written without holding the lock
+    std::vector<ThreadBuffer *> buffers;
+    {
+        std::lock_guard<std::mutex> lock(s_BuffersMutex);
+        buffers.reserve(s_Buffers.size());
+        for (const auto &buffer : s_Buffers)
+            buffers.push_back(buffer.get());
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (ThreadBuffer *buffer : buffers)
+    {
+        uint64_t end = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = end > TRACE_BUFFER_CAPACITY ? end - TRACE_BUFFER_CAPACITY : 0;
+
+        snapshot.clear();
+        for (uint64_t i = begin; i < end; i++)
+            snapshot.push_back(buffer->events[i % TRACE_BUFFER_CAPACITY]);
+
+        // the owner kept recording while we copied, drop anything it may have overwritten;
+        // the slot at index latest may already be mid-write, so it counts as overwritten too
+        uint64_t latest = buffer->head.load(std::memory_order_acquire);
+        std::size_t overwritten =
+            latest + 1 > begin + TRACE_BUFFER_CAPACITY ? latest + 1 - TRACE_BUFFER_CAPACITY - begin : 0;
+        overwritten = std::min(overwritten, snapshot.size());
+
+        if (const char *threadName = buffer->threadName.load(std::memory_order_acquire))
+        {
+            file << (first ? "" : ",") << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+                 << buffer->threadID << ",\"args\":{\"name\":";
+            WriteJsonString(file, threadName);
+            file << "}}";
+            first = false;
+        }
+
+        for (std::size_t i = overwritten; i < snapshot.size(); i++)
+        {
+            const TraceEvent &event = snapshot[i];
+            file << (first ? "" : ",") << "\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadID << ",\"name\":";
+            if (event.detail)
+                WriteJsonString(file, fmt::format("{} {}", event.detail, event.name).c_str());
+            else
+                WriteJsonString(file, event.name);
+            file << fmt::format(",\"ts\":{:.3f},\"dur\":{:.3f}}}", event.startNs / 1000.0, event.durationNs / 1000.0);
+            first = false;
+        }
+        eventCount += snapshot.size() - overwritten;
+    }
+
+    file << "\n]}\n";
+    Logger::Info("Profiler: wrote {} events from {} threads to {}", eventCount, buffers.size(), path);
+    return true;
+}
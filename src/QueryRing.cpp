@@ -0,0 +1,66 @@
+#include "QueryRing.hpp"
+#include "GLCall.hpp"
+
+QueryRing::QueryRing(GLenum target, uint32_t size)
+    : m_Target(target),
+      m_Queries(size == 0 ? 1 : size, 0),
+      m_WriteIndex(0),
+      m_ReadIndex(0),
+      m_Pending(0),
+      m_Active(false),
+      m_LastResult(0),
+      m_HasResult(false),
+      m_Skipped(0)
+{
+    GL_CALL(Query, glGenQueries(static_cast<GLsizei>(m_Queries.size()), m_Queries.data()));
+}
+
+QueryRing::~QueryRing()
+{
+    GL_CALL(Query, glDeleteQueries(static_cast<GLsizei>(m_Queries.size()), m_Queries.data()));
+}
+
+void QueryRing::Begin()
+{
+    Poll();
+    if (m_Pending == m_Queries.size())
+    {
+        m_Skipped++;
+        return;
+    }
+
+    GL_CALL(Query, glBeginQuery(m_Target, m_Queries[m_WriteIndex]));
+    m_Active = true;
+}
+
+void QueryRing::End()
+{
+    if (!m_Active)
+        return;
+
+    GL_CALL(Query, glEndQuery(m_Target));
+    m_Active = false;
+    m_WriteIndex = (m_WriteIndex + 1) % m_Queries.size();
+    m_Pending++;
+}
+
+bool QueryRing::Poll()
+{
+    bool updated = false;
+
+    // queries complete in order, stop at the first one still in flight
+    while (m_Pending > 0)
+    {
+        GLuint available = GL_FALSE;
+        GL_CALL(Query, glGetQueryObjectuiv(m_Queries[m_ReadIndex], GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available)
+            break;
+
+        GL_CALL(Query, glGetQueryObjectui64v(m_Queries[m_ReadIndex], GL_QUERY_RESULT, &m_LastResult));
+        m_HasResult = true;
+        updated = true;
+        m_ReadIndex = (m_ReadIndex + 1) % m_Queries.size();
+        m_Pending--;
+    }
+    return updated;
+}
@@ -0,0 +1,429 @@
+#include "ResourceManager.hpp"
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "Logger.hpp"
+#include "Profiler.hpp"
+#include "AllocationTracker.hpp"
+
+static constexpr uint32_t NO_ALIAS = UINT32_MAX;
+
+const char *ResourceStateName(ResourceState state)
+{
+    switch (state)
+    {
+    case ResourceState::Loading:
+        return "Loading";
+    case ResourceState::Decoded:
+        return "Decoded";
+    case ResourceState::Resident:
+        return "Resident";
+    case ResourceState::Evicted:
+        return "Evicted";
+    case ResourceState::Failed:
+        return "Failed";
+    }
+    return "Unknown";
+}
+
+// FNV-1a, only used to spot identical files under different names
+static uint64_t HashBytes(const std::vector<unsigned char> &bytes)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char byte : bytes)
+        hash = (hash ^ byte) * 1099511628211ull;
+    return hash;
+}
+
+static std::string NormalizePath(const std::string &path)
+{
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+template <typename Slot>
+static void NextGeneration(Slot &slot)
+{
+    // 0 marks an invalid handle, skip it on wrap-around
+    if (++slot.generation == 0)
+        slot.generation = 1;
+}
+
+ResourceManager::ResourceManager(JobSystem &jobs, std::size_t vramBudgetBytes)
+    : m_Jobs(jobs),
+      m_TexturePath("assets/textures/"),
+      m_ShaderPath("assets/shaders/"),
+      m_VramBudget(vramBudgetBytes),
+      m_VramUsed(0),
+      m_Frame(0),
+      m_Pending(0),
+      m_Evictions(0),
+      m_OverBudgetWarned(false)
+{
+    // mid grey, drawn in place of textures that are still loading
+    const unsigned char grey[3] = {128, 128, 128};
+    m_Placeholder = std::make_unique<Texture>(grey, 1, 1, 3);
+    Logger::Info("ResourceManager: VRAM budget {} MB", m_VramBudget / (1024 * 1024));
+}
+
+ResourceManager::~ResourceManager()
+{
+    // decode jobs write into the slots, let them finish before the slots go away
+    for (auto &slot : m_Textures)
+        m_Jobs.Wait(slot->decodeJob);
+}
+
+TextureHandle ResourceManager::LoadTexture(const std::string &path)
+{
+    std::string fullPath = NormalizePath(m_TexturePath + path);
+    auto existing = m_TexturesByPath.find(fullPath);
+    if (existing != m_TexturesByPath.end())
+    {
+        TextureSlot &slot = *m_Textures[existing->second];
+        slot.references++;
+        return {existing->second, slot.generation};
+    }
+
+    uint32_t index;
+    if (!m_FreeTextures.empty())
+    {
+        index = m_FreeTextures.back();
+        m_FreeTextures.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_Textures.size());
+        m_Textures.push_back(std::make_unique<TextureSlot>());
+    }
+
+    TextureSlot &slot = *m_Textures[index];
+    slot.references = 1;
+    slot.path = fullPath;
+    slot.aliasOf = NO_ALIAS;
+    slot.lastUsedFrame = m_Frame;
+    m_TexturesByPath[fullPath] = index;
+    QueueDecode(slot);
+
+    Logger::Info("Texture: loading {}", fullPath);
+    return {index, slot.generation};
+}
+
+ShaderHandle ResourceManager::LoadShader(const std::string &vertexPath, const std::string &fragmentPath)
+{
+    std::string fullVertexPath = NormalizePath(m_ShaderPath + vertexPath);
+    std::string fullFragmentPath = NormalizePath(m_ShaderPath + fragmentPath);
+    std::string key = fullVertexPath + "|" + fullFragmentPath;
+
+    auto existing = m_ShadersByKey.find(key);
+    if (existing != m_ShadersByKey.end())
+    {
+        ShaderSlot &slot = m_Shaders[existing->second];
+        slot.references++;
+        return {existing->second, slot.generation};
+    }
+
+    uint32_t index;
+    if (!m_FreeShaders.empty())
+    {
+        index = m_FreeShaders.back();
+        m_FreeShaders.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_Shaders.size());
+        m_Shaders.emplace_back();
+    }
+
+    Logger::Info("Shader: compiling {} + {}", fullVertexPath, fullFragmentPath);
+    ShaderSlot &slot = m_Shaders[index];
+    slot.references = 1;
+    slot.key = key;
+    slot.shader = std::make_unique<Shader>(fullVertexPath.c_str(), fullFragmentPath.c_str());
+    m_ShadersByKey[key] = index;
+    return {index, slot.generation};
+}
+
+void ResourceManager::Release(TextureHandle handle)
+{
+    TextureSlot *slot = Resolve(handle);
+    if (!slot || slot->references == 0)
+    {
+        Logger::Warn("ResourceManager: release of a stale texture handle");
+        return;
+    }
+
+    if (--slot->references > 0)
+        return;
+
+    // the outstanding handles are dead even if the texture stays cached, LoadTexture hands out
+    // the new generation when the path is asked for again
+    NextGeneration(*slot);
+
+    // unreferenced resident textures stay cached until the budget needs the space, anything
+    // without its own texture (aliases, failed, evicted, still loading) goes right away
+    if (!slot->texture)
+        FreeTexture(handle.index);
+}
+
+void ResourceManager::Release(ShaderHandle handle)
+{
+    if (handle.index >= m_Shaders.size() || m_Shaders[handle.index].generation != handle.generation)
+    {
+        Logger::Warn("ResourceManager: release of a stale shader handle");
+        return;
+    }
+
+    ShaderSlot &slot = m_Shaders[handle.index];
+    if (--slot.references > 0)
+        return;
+
+    m_ShadersByKey.erase(slot.key);
+    slot.key.clear();
+    slot.shader.reset();
+    NextGeneration(slot);
+    m_FreeShaders.push_back(handle.index);
+}
+
+Texture *ResourceManager::Get(TextureHandle handle)
+{
+    TextureSlot *slot = Resolve(handle);
+    if (!slot)
+        return nullptr;
+
+    slot->lastUsedFrame = m_Frame;
+    if (slot->aliasOf != NO_ALIAS)
+    {
+        TextureSlot &owner = *m_Textures[slot->aliasOf];
+        return Get(TextureHandle{slot->aliasOf, owner.generation});
+    }
+
+    switch (slot->state)
+    {
+    case ResourceState::Resident:
+        return slot->texture.get();
+    case ResourceState::Evicted:
+        // wanted again, stream it back in
+        QueueDecode(*slot);
+        return m_Placeholder.get();
+    default:
+        return m_Placeholder.get();
+    }
+}
+
+Shader *ResourceManager::Get(ShaderHandle handle) const
+{
+    if (handle.index >= m_Shaders.size() || m_Shaders[handle.index].generation != handle.generation)
+        return nullptr;
+    return m_Shaders[handle.index].shader.get();
+}
+
+ResourceState ResourceManager::GetState(TextureHandle handle) const
+{
+    TextureSlot *slot = Resolve(handle);
+    return slot ? slot->state : ResourceState::Failed;
+}
+
+ResourceManager::TextureSlot *ResourceManager::Resolve(TextureHandle handle) const
+{
+    if (handle.index >= m_Textures.size())
+        return nullptr;
+    TextureSlot *slot = m_Textures[handle.index].get();
+    return slot->generation == handle.generation && !slot->path.empty() ? slot : nullptr;
+}
+
+void ResourceManager::QueueDecode(TextureSlot &slot)
+{
+    slot.state = ResourceState::Loading;
+    m_Jobs.SubmitBackground(&ResourceManager::DecodeTextureJob, &slot, slot.decodeJob, "DecodeTexture");
+}
+
+void ResourceManager::DecodeTextureJob(void *data, uint32_t, uint32_t)
+{
+    AllocationScope allocationScope(AllocTag::Resources);
+    auto *slot = static_cast<TextureSlot *>(data);
+
+    std::ifstream file(slot->path, std::ios::binary);
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.empty())
+    {
+        Logger::Error("Failed to read texture: {}", slot->path);
+        return;
+    }
+
+    slot->contentHash = HashBytes(bytes);
+    slot->image.Decode(bytes.data(), bytes.size(), slot->path);
+}
+
+void ResourceManager::Update()
+{
+    PROFILE_FUNCTION();
+    m_Frame++;
+
+    uint32_t uploads = 0;
+    m_Pending = 0;
+    for (uint32_t index = 0; index < m_Textures.size(); index++)
+    {
+        TextureSlot &slot = *m_Textures[index];
+        if (slot.state == ResourceState::Loading && slot.decodeJob.IsDone())
+            slot.state = ResourceState::Decoded;
+
+        // a few uploads per frame, glTexImage2D + mipmaps of a large texture is a visible hitch
+        if (slot.state == ResourceState::Decoded && uploads < MAX_UPLOADS_PER_FRAME)
+        {
+            Upload(index);
+            uploads++;
+        }
+
+        if (slot.state == ResourceState::Loading || slot.state == ResourceState::Decoded)
+            m_Pending++;
+    }
+
+    EnforceBudget();
+}
+
+void ResourceManager::Upload(uint32_t index)
+{
+    TextureSlot &slot = *m_Textures[index];
+    if (!slot.image.pixels)
+    {
+        slot.state = ResourceState::Failed;
+        return;
+    }
+
+    // same bytes as a texture already loaded under another path, share it
+    auto sameContent = m_TexturesByContent.find(slot.contentHash);
+    if (sameContent != m_TexturesByContent.end() && sameContent->second != index)
+    {
+        TextureSlot &owner = *m_Textures[sameContent->second];
+        owner.references++;
+        slot.aliasOf = sameContent->second;
+        slot.state = ResourceState::Resident;
+        slot.image.Reset();
+        Logger::Info("Texture: {} has the same content as {}, sharing it", slot.path, owner.path);
+        return;
+    }
+
+    slot.texture = std::make_unique<Texture>(slot.image);
+    // a full mip chain adds a third on top of the base level
+    slot.bytes = static_cast<std::size_t>(slot.image.width) * slot.image.height * slot.image.channels * 4 / 3;
+    slot.state = ResourceState::Resident;
+    slot.lastUsedFrame = m_Frame;
+    slot.image.Reset();
+    m_VramUsed += slot.bytes;
+    m_TexturesByContent[slot.contentHash] = index;
+}
+
+void ResourceManager::Evict(uint32_t index)
+{
+    TextureSlot &slot = *m_Textures[index];
+    m_Evictions++;
+    if (slot.references == 0)
+    {
+        FreeTexture(index);
+        return;
+    }
+
+    m_VramUsed -= slot.bytes;
+    slot.bytes = 0;
+    slot.texture.reset();
+    slot.state = ResourceState::Evicted;
+    LOG_DEBUG("Texture: evicted {}", slot.path);
+}
+
+void ResourceManager::FreeTexture(uint32_t index)
+{
+    TextureSlot &slot = *m_Textures[index];
+    m_Jobs.Wait(slot.decodeJob);
+
+    if (slot.texture)
+        m_VramUsed -= slot.bytes;
+    slot.texture.reset();
+    slot.image.Reset();
+    slot.bytes = 0;
+
+    auto sameContent = m_TexturesByContent.find(slot.contentHash);
+    if (sameContent != m_TexturesByContent.end() && sameContent->second == index)
+        m_TexturesByContent.erase(sameContent);
+    m_TexturesByPath.erase(slot.path);
+    LOG_DEBUG("Texture: freed {}", slot.path);
+    slot.path.clear();
+
+    uint32_t owner = slot.aliasOf;
+    slot.aliasOf = NO_ALIAS;
+    m_FreeTextures.push_back(index);
+
+    // the alias held a reference on the texture it shared
+    if (owner != NO_ALIAS)
+        Release(TextureHandle{owner, m_Textures[owner]->generation});
+}
+
+void ResourceManager::EnforceBudget()
+{
+    while (m_VramUsed > m_VramBudget)
+    {
+        // unreferenced first, then least recently used; anything drawn very recently stays
+        uint32_t victim = NO_ALIAS;
+        for (uint32_t index = 0; index < m_Textures.size(); index++)
+        {
+            const TextureSlot &slot = *m_Textures[index];
+            if (slot.state != ResourceState::Resident || !slot.texture ||
+                slot.lastUsedFrame + EVICTION_GRACE_FRAMES > m_Frame)
+                continue;
+
+            if (victim == NO_ALIAS)
+            {
+                victim = index;
+                continue;
+            }
+            const TextureSlot &best = *m_Textures[victim];
+            bool unreferenced = slot.references == 0;
+            bool bestUnreferenced = best.references == 0;
+            if (unreferenced != bestUnreferenced ? unreferenced : slot.lastUsedFrame < best.lastUsedFrame)
+                victim = index;
+        }
+
+        if (victim == NO_ALIAS)
+        {
+            if (!m_OverBudgetWarned)
+                Logger::Warn("ResourceManager: {} MB in use, over the {} MB budget with nothing evictable",
+                             m_VramUsed / (1024 * 1024), m_VramBudget / (1024 * 1024));
+            m_OverBudgetWarned = true;
+            return;
+        }
+        Evict(victim);
+    }
+    m_OverBudgetWarned = false;
+}
+
+void ResourceManager::GetTextureInfo(std::vector<TextureInfo> &rows) const
+{
+    rows.clear();
+    for (const auto &slot : m_Textures)
+        if (!slot->path.empty())
+            rows.push_back({&slot->path, slot->state, slot->references, slot->bytes, slot->aliasOf != NO_ALIAS});
+}
+
+std::unique_ptr<ResourceManager> ResourceManager::FromCommandLine(JobSystem &jobs, int argc, char **argv)
+{
+    auto manager = std::make_unique<ResourceManager>(jobs);
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--vram-budget") != 0)
+            continue;
+
+        // digits only, small enough that the byte count does not overflow
+        const char *text = argv[i + 1];
+        char *end = nullptr;
+        errno = 0;
+        unsigned long long megabytes = std::strtoull(text, &end, 10);
+        if (!std::isdigit(static_cast<unsigned char>(text[0])) || errno != 0 || *end != '\0' ||
+            megabytes > SIZE_MAX / (1024 * 1024))
+            Logger::Warn("--vram-budget: '{}' is not a size in MB, keeping {} MB", text,
+                         manager->GetVramBudget() / (1024 * 1024));
+        else
+            manager->SetVramBudget(static_cast<std::size_t>(megabytes) * 1024 * 1024);
+    }
+    return manager;
+}
@@ -4,11 +4,17 @@
 #include <stdexcept>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "GLCall.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
+#include "FrameStats.hpp"
+#include "AllocationTracker.hpp"
 
 // each shader file can have more than one type (vertex and fragment combiend)
 Shader::Shader(const char *shaderFilePath)
 {
+    PROFILE_FUNCTION();
+    AllocationScope allocationScope(AllocTag::Resources);
     std::string source = ReadFile(shaderFilePath);
     auto preprocessedSources = PreProcess(source);
 
@@ -23,12 +29,14 @@ Shader::Shader(const char *shaderFilePath)
     // Cleanup
     for (auto shader : shaders)
     {
-        glDeleteShader(shader);
+        GL_CALL(Shader, glDeleteShader(shader));
     }
 }
 
 Shader::Shader(const char *vertexShaderPath, const char *fragmentShaderPath)
 {
+    PROFILE_FUNCTION();
+    AllocationScope allocationScope(AllocTag::Resources);
     std::string vertexSource = ReadFile(vertexShaderPath);
     std::string fragmentSource = ReadFile(fragmentShaderPath);
 
@@ -43,33 +51,33 @@ Shader::Shader(const char *vertexShaderPath, const char *fragmentShaderPath)
     // Cleanup
     for (auto shader : shaders)
     {
-        glDeleteShader(shader);
+        GL_CALL(Shader, glDeleteShader(shader));
     }
 }
 
 Shader::~Shader()
 {
-    glDeleteProgram(m_ID);
+    GL_CALL(Shader, glDeleteProgram(m_ID));
 }
 
 void Shader::UseProgram() const
 {
-    glUseProgram(m_ID);
+    GL_CALL(Bind, glUseProgram(m_ID));
 }
 
 void Shader::DeleteProgram() const
 {
-    glUseProgram(0);
+    GL_CALL(Bind, glUseProgram(0));
 }
 
 void Shader::Bind() const
 {
-    glUseProgram(m_ID);
+    GL_CALL(Bind, glUseProgram(m_ID));
 }
 
 void Shader::UnBind() const
 {
-    glUseProgram(0);
+    GL_CALL(Bind, glUseProgram(0));
 }
 
 std::string Shader::ReadFile(const char *shaderFilePath) const
@@ -116,9 +124,9 @@ std::unordered_map<GLenum, std::string> Shader::PreProcess(const std::string &so
 
 GLuint Shader::CompileShader(const char *source, GLenum shaderType) const
 {
-    GLuint shader = glCreateShader(shaderType);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
+    GLuint shader = GL_CALL(Shader, glCreateShader(shaderType));
+    GL_CALL(Shader, glShaderSource(shader, 1, &source, nullptr));
+    GL_CALL(Shader, glCompileShader(shader));
     CheckCompileErrors(shader, shaderType);
 
     Logger::Info("Shader compiled with program ID: {}", shader);
@@ -127,12 +135,12 @@ GLuint Shader::CompileShader(const char *source, GLenum shaderType) const
 
 void Shader::LinkProgram(const std::vector<GLuint> &shaders)
 {
-    m_ID = glCreateProgram();
+    m_ID = GL_CALL(Shader, glCreateProgram());
     for (auto shader : shaders)
     {
-        glAttachShader(m_ID, shader);
+        GL_CALL(Shader, glAttachShader(m_ID, shader));
     }
-    glLinkProgram(m_ID);
+    GL_CALL(Shader, glLinkProgram(m_ID));
     CheckLinkErrors(m_ID);
     Logger::Info("Shader linked with ID: {}", m_ID);
 }
@@ -140,11 +148,11 @@ void Shader::LinkProgram(const std::vector<GLuint> &shaders)
 void Shader::CheckCompileErrors(GLuint shader, GLenum type) const
 {
     GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    GL_CALL(Shader, glGetShaderiv(shader, GL_COMPILE_STATUS, &success));
     if (!success)
     {
         GLchar infoLog[1024];
-        glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
+        GL_CALL(Shader, glGetShaderInfoLog(shader, 1024, nullptr, infoLog));
         throw std::runtime_error("Shader compilation error (" + std::to_string(type) + "): " + infoLog);
     }
 }
@@ -152,158 +160,83 @@ void Shader::CheckCompileErrors(GLuint shader, GLenum type) const
 void Shader::CheckLinkErrors(GLuint program) const
 {
     GLint success;
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    GL_CALL(Shader, glGetProgramiv(program, GL_LINK_STATUS, &success));
     if (!success)
     {
         GLchar infoLog[1024];
-        glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+        GL_CALL(Shader, glGetProgramInfoLog(program, 1024, nullptr, infoLog));
         throw std::runtime_error("Program linking error: " + std::string(infoLog));
     }
 }
 
 void Shader::UploadUniform1f(const std::string &name, const float &val)
 {
-    glUniform1f(GetUniformLocation(name), val);
+    GL_CALL(Uniform, glUniform1f(GetUniformLocation(name), val));
 }
 
 void Shader::UploadUniform2f(const std::string &name, const glm::vec2 &val)
 {
-    glUniform2f(GetUniformLocation(name), val.x, val.y);
+    GL_CALL(Uniform, glUniform2f(GetUniformLocation(name), val.x, val.y));
 }
 
 void Shader::UploadUniform3f(const std::string &name, const glm::vec3 &val)
 {
-    glUniform3f(GetUniformLocation(name), val.x, val.y, val.z);
+    GL_CALL(Uniform, glUniform3f(GetUniformLocation(name), val.x, val.y, val.z));
 }
 
 void Shader::UploadUniform4f(const std::string &name, const glm::vec4 &val)
 {
-    glUniform4f(GetUniformLocation(name), val.x, val.y, val.z, val.w);
+    GL_CALL(Uniform, glUniform4f(GetUniformLocation(name), val.x, val.y, val.z, val.w));
 }
 
 void Shader::UploadUniform1i(const std::string &name, const int &val)
 {
-    glUniform1i(GetUniformLocation(name), val);
+    GL_CALL(Uniform, glUniform1i(GetUniformLocation(name), val));
 }
 
 void Shader::UploadUniform2i(const std::string &name, const glm::ivec2 &val)
 {
-    glUniform2i(GetUniformLocation(name), val.x, val.y);
+    GL_CALL(Uniform, glUniform2i(GetUniformLocation(name), val.x, val.y));
 }
 
 void Shader::UploadUniform3i(const std::string &name, const glm::ivec3 &val)
 {
-    glUniform3i(GetUniformLocation(name), val.x, val.y, val.z);
+    GL_CALL(Uniform, glUniform3i(GetUniformLocation(name), val.x, val.y, val.z));
 }
 
 void Shader::UploadUniform4i(const std::string &name, const glm::ivec4 &val)
 {
-    glUniform4i(GetUniformLocation(name), val.x, val.y, val.z, val.w);
+    GL_CALL(Uniform, glUniform4i(GetUniformLocation(name), val.x, val.y, val.z, val.w));
 }
 
 void Shader::UploadUniformMat2(const std::string &name, const glm::mat2 &val)
 {
-    glUniformMatrix2fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(val));
+    GL_CALL(Uniform, glUniformMatrix2fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(val)));
 }
 
 void Shader::UploadUniformMat3(const std::string &name, const glm::mat3 &val)
 {
-    glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(val));
+    GL_CALL(Uniform, glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(val)));
 }
 
 void Shader::UploadUniformMat4(const std::string &name, const glm::mat4 &val)
 {
-    glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(val));
+    GL_CALL(Uniform, glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(val)));
 }
 
 GLint Shader::GetUniformLocation(const std::string &uniformName)
 {
+    // every UploadUniform* goes through here
+    FrameStats::CountUniformUpload();
+
     // return from cache
     if (m_UniformLocationCache.find(uniformName) != m_UniformLocationCache.end())
         return m_UniformLocationCache[uniformName];
 
-    auto location = glGetUniformLocation(m_ID, uniformName.c_str());
+    auto location = GL_CALL(Shader, glGetUniformLocation(m_ID, uniformName.c_str()));
     if (location == -1)
         Logger::Warn("ShaderID-{} uniform {} not found!", m_ID, uniformName);
     m_UniformLocationCache[uniformName] = location;
 
     return location;
 }
-
-ShaderManager::ShaderManager()
-    : m_ShaderDefaultPath("assets/shaders/")
-{
-}
-
-ShaderManager::~ShaderManager()
-{
-    for (auto &shader : m_Shaders)
-    {
-        delete shader.second;
-    }
-    m_Shaders.clear();
-    m_ShaderNames.clear();
-}
-
-void ShaderManager::AddShader(const std::string &shaderName, const std::string &vertexShaderPath, const std::string &fragmentShaderPath)
-{
-    if (m_Shaders.find(shaderName) != m_Shaders.end())
-    {
-        std::cerr << "Shader already exists: " << shaderName << "\n";
-        return;
-    }
-    std::string fullVertexShaderPath = m_ShaderDefaultPath + vertexShaderPath;
-    std::string fullFragmentShaderPath = m_ShaderDefaultPath + fragmentShaderPath;
-
-    Logger::Info("Shader: '{}' added from path {}", shaderName, fullVertexShaderPath);
-    Logger::Info("Shader: '{}' added from path {}", shaderName, fullFragmentShaderPath);
-
-    m_Shaders[shaderName] = new Shader(fullVertexShaderPath.c_str(), fullFragmentShaderPath.c_str());
-    m_ShaderNames.push_back(shaderName);
-}
-
-void ShaderManager::RemoveShader(const std::string &shaderName)
-{
-    auto it = m_Shaders.find(shaderName);
-    if (it == m_Shaders.end())
-    {
-        throw std::runtime_error("Shader with name " + shaderName + " not found.");
-    }
-
-    // Delete the shader and remove from the map
-    delete it->second;
-    m_Shaders.erase(it);
-
-    // Remove the shader name from the list
-    auto nameIt = std::find(m_ShaderNames.begin(), m_ShaderNames.end(), shaderName);
-    if (nameIt != m_ShaderNames.end())
-    {
-        m_ShaderNames.erase(nameIt);
-    }
-
-    Logger::Info("Shader removed: {}", shaderName);
-}
-
-void ShaderManager::UseShader(const std::string &shaderName)
-{
-    if (m_Shaders.find(shaderName) == m_Shaders.end())
-    {
-        throw std::runtime_error("Shader with name " + shaderName + " not found.");
-    }
-    m_Shaders[shaderName]->UseProgram();
-}
-
-Shader *ShaderManager::GetShader(const std::string &shaderName)
-{
-    auto it = m_Shaders.find(shaderName);
-    if (it == m_Shaders.end())
-    {
-        throw std::runtime_error("Shader with name " + shaderName + " not found.");
-    }
-    return it->second;
-}
-
-std::unique_ptr<ShaderManager> ShaderManager::Create()
-{
-    return std::make_unique<ShaderManager>();
-}
\ No newline at end of file
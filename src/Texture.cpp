@@ -2,63 +2,135 @@
 #include "Texture.hpp"
 #include "stb_image.h"
 #include <iostream>
+#include "GLCall.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
+#include "AllocationTracker.hpp"
+
+TextureImage::~TextureImage()
+{
+    Reset();
+}
+
+void TextureImage::Reset()
+{
+    if (pixels)
+        stbi_image_free(pixels);
+    pixels = nullptr;
+    width = height = channels = 0;
+}
+
+bool TextureImage::Decode(const std::string &filePath)
+{
+    PROFILE_FUNCTION();
+    AllocationScope allocationScope(AllocTag::Resources);
+    path = filePath;
+    pixels = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
+    if (!pixels)
+    {
+        std::cerr << "Failed to load texture: " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TextureImage::Decode(const unsigned char *data, std::size_t size, const std::string &sourcePath)
+{
+    PROFILE_FUNCTION();
+    AllocationScope allocationScope(AllocTag::Resources);
+    Reset();
+    path = sourcePath;
+    pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, 0);
+    if (!pixels)
+    {
+        std::cerr << "Failed to load texture: " << sourcePath << std::endl;
+        return false;
+    }
+    return true;
+}
 
 Texture::Texture(const std::string &path)
     : m_TextureID(0), m_Width(0), m_Height(0), m_NrChannels(0), m_TextureType(GL_TEXTURE_2D)
 {
-    LoadFromFile(path);
+    TextureImage image;
+    image.Decode(path);
+    Upload(image.pixels, image.width, image.height, image.channels);
+    SetDefaultParameters();
+}
+
+Texture::Texture(const TextureImage &image)
+    : m_TextureID(0), m_Width(0), m_Height(0), m_NrChannels(0), m_TextureType(GL_TEXTURE_2D)
+{
+    Upload(image.pixels, image.width, image.height, image.channels);
     SetDefaultParameters();
 }
 
-Texture::Texture(const std::vector<std::string> &cubeFaces)
+Texture::Texture(const unsigned char *pixels, int width, int height, int channels)
+    : m_TextureID(0), m_Width(0), m_Height(0), m_NrChannels(0), m_TextureType(GL_TEXTURE_2D)
+{
+    Upload(pixels, width, height, channels);
+    SetDefaultParameters();
+}
+
+Texture::Texture(const std::vector<std::string> &cubeFaces, JobSystem *jobs)
     : m_TextureType(GL_TEXTURE_CUBE_MAP)
 {
-    LoadCubemap(cubeFaces);
+    LoadCubemap(cubeFaces, jobs);
     SetDefaultParameters();
 }
 
 Texture::~Texture()
 {
     if (m_TextureID)
-        glDeleteTextures(1, &m_TextureID);
+        GL_CALL(Texture, glDeleteTextures(1, &m_TextureID));
 }
 
-void Texture::LoadFromFile(const std::string &path)
+void Texture::Upload(const unsigned char *pixels, int width, int height, int channels)
 {
-    unsigned char *data = stbi_load(path.c_str(), &m_Width, &m_Height, &m_NrChannels, 0);
-    if (!data)
-    {
-        std::cerr << "Failed to load texture: " << path << std::endl;
+    PROFILE_FUNCTION();
+    if (!pixels)
         return;
-    }
 
+    m_Width = width;
+    m_Height = height;
+    m_NrChannels = channels;
     GLenum format = (m_NrChannels == 4) ? GL_RGBA : GL_RGB;
-    glGenTextures(1, &m_TextureID); // Generate unique texture ID
-    glBindTexture(m_TextureType, m_TextureID);
-    glTexImage2D(m_TextureType, 0, format, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(m_TextureType);
-
-    stbi_image_free(data);
+    GL_CALL(Texture, glGenTextures(1, &m_TextureID)); // Generate unique texture ID
+    GL_CALL(Bind, glBindTexture(m_TextureType, m_TextureID));
+    GL_CALL(Texture, glTexImage2D(m_TextureType, 0, format, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, pixels));
+    GL_CALL(Texture, glGenerateMipmap(m_TextureType));
 }
 
-void Texture::LoadCubemap(const std::vector<std::string> &cubeFaces)
+void Texture::LoadCubemap(const std::vector<std::string> &cubeFaces, JobSystem *jobs)
 {
-    glGenTextures(1, &m_TextureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID);
+    PROFILE_FUNCTION();
+    AllocationScope allocationScope(AllocTag::Resources);
 
-    int width, height, nrChannels;
-    for (unsigned int i = 0; i < cubeFaces.size(); i++)
+    // decoding dominates (4k faces), the uploads below have to stay on the GL thread
+    std::vector<TextureImage> faces(cubeFaces.size());
+    auto decode = [&cubeFaces, &faces](uint32_t begin, uint32_t end)
     {
-        unsigned char *data = stbi_load(cubeFaces[i].c_str(), &width, &height, &nrChannels, 0);
-        if (data)
+        for (uint32_t i = begin; i < end; i++)
+            faces[i].Decode(cubeFaces[i]);
+    };
+    if (jobs)
+        jobs->ParallelFor(static_cast<uint32_t>(faces.size()), 1, decode, "DecodeCubemapFace");
+    else
+        decode(0, static_cast<uint32_t>(faces.size()));
+
+    GL_CALL(Texture, glGenTextures(1, &m_TextureID));
+    GL_CALL(Bind, glBindTexture(GL_TEXTURE_CUBE_MAP, m_TextureID));
+
+    for (unsigned int i = 0; i < faces.size(); i++)
+    {
+        const TextureImage &face = faces[i];
+        if (face.pixels)
         {
-            GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-            GLenum internalFormat = (nrChannels == 4) ? GL_SRGB_ALPHA : GL_SRGB;
-            Logger::Debug("Loaded cubemap face: {} ({}x{}, {} channels)", cubeFaces[i], width, height, nrChannels);
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
-                         0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-            stbi_image_free(data);
+            GLenum format = (face.channels == 4) ? GL_RGBA : GL_RGB;
+            GLenum internalFormat = (face.channels == 4) ? GL_SRGB_ALPHA : GL_SRGB;
+            LOG_DEBUG("Loaded cubemap face: {} ({}x{}, {} channels)", face.path, face.width, face.height, face.channels);
+            GL_CALL(Texture, glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
+                         0, internalFormat, face.width, face.height, 0, format, GL_UNSIGNED_BYTE, face.pixels));
         }
         else
         {
@@ -69,31 +141,31 @@ void Texture::LoadCubemap(const std::vector<std::string> &cubeFaces)
 
 void Texture::Bind(GLenum textureUnit) const
 {
-    glActiveTexture(textureUnit);
-    glBindTexture(m_TextureType, m_TextureID);
+    GL_CALL(Bind, glActiveTexture(textureUnit));
+    GL_CALL(Bind, glBindTexture(m_TextureType, m_TextureID));
 }
 
 void Texture::Unbind() const
 {
-    glBindTexture(m_TextureType, 0);
+    GL_CALL(Bind, glBindTexture(m_TextureType, 0));
 }
 
 void Texture::SetDefaultParameters()
 {
     if (m_TextureType == GL_TEXTURE_2D)
     {
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        GL_CALL(Texture, glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+        GL_CALL(Texture, glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+        GL_CALL(Texture, glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
+        GL_CALL(Texture, glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
     }
     else if (m_TextureType == GL_TEXTURE_CUBE_MAP)
     {
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        GL_CALL(Texture, glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+        GL_CALL(Texture, glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+        GL_CALL(Texture, glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        GL_CALL(Texture, glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        GL_CALL(Texture, glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE));
     }
 }
 
@@ -101,77 +173,3 @@ std::pair<int, int> Texture::GetDimensions() const
 {
     return {m_Width, m_Height};
 }
-
-TextureManager::TextureManager()
-    : m_TextureDefaultPath("assets/textures/")
-{
-}
-
-TextureManager::~TextureManager()
-{
-    ClearTextures();
-}
-
-void TextureManager::AddTexture(const std::string &name, const std::string &path)
-{
-    if (m_Textures.find(name) == m_Textures.end())
-    {
-        std::string fullPath = m_TextureDefaultPath + path;
-        m_Textures[name] = new Texture(fullPath);
-        Logger::Info("Texture: '{}' added from path {}", name, fullPath);
-    }
-    else
-    {
-        std::cerr << "Texture with name \"" << name << "\" already exists.\n";
-    }
-    m_TextureNames.push_back(name);
-}
-
-Texture *TextureManager::GetTexture(const std::string &name) const
-{
-    auto it = m_Textures.find(name);
-    if (it != m_Textures.end())
-    {
-        return it->second;
-    }
-
-    std::cerr << "Texture with name \"" << name << "\" not found.\n";
-    return nullptr;
-}
-
-void TextureManager::RemoveTexture(const std::string &name)
-{
-    auto it = m_Textures.find(name);
-    if (it == m_Textures.end())
-    {
-        throw std::runtime_error("Texture with name " + name + " not found.");
-    }
-
-    // Delete the shader and remove from the map
-    delete it->second;
-    m_Textures.erase(it);
-
-    // Remove the shader name from the list
-    auto nameIt = std::find(m_TextureNames.begin(), m_TextureNames.end(), name);
-    if (nameIt != m_TextureNames.end())
-    {
-        m_TextureNames.erase(nameIt);
-    }
-
-    Logger::Info("Texture removed: {}", name);
-}
-
-void TextureManager::ClearTextures()
-{
-    for (auto &pair : m_Textures)
-    {
-        delete pair.second;
-    }
-    m_Textures.clear();
-    m_TextureNames.clear();
-}
-
-std::unique_ptr<TextureManager> TextureManager::Create()
-{
-    return std::make_unique<TextureManager>();
-}
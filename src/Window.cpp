@@ -4,7 +4,9 @@
 #include "events/KeyEvent.hpp"
 #include "events/WindowEvent.hpp"
 #include "events/MouseEvent.hpp"
+#include "GLCall.hpp"
 #include "Logger.hpp"
+#include "Profiler.hpp"
 
 Window::Window(const InitializeWindowProps &props)
     : m_Window(nullptr)
@@ -32,9 +34,9 @@ void Window::Initialize(const InitializeWindowProps &props)
 
     if (primaryMonitor && mode)
     {
-        Logger::Debug("Primary Monitor Width: {}", mode->width);
-        Logger::Debug("Primary Monitor Height: {}", mode->height);
-        Logger::Debug("Window Aspect Ratio: {}", static_cast<float>(m_WindowProperties.m_Width) / static_cast<float>(m_WindowProperties.m_Height));
+        LOG_DEBUG("Primary Monitor Width: {}", mode->width);
+        LOG_DEBUG("Primary Monitor Height: {}", mode->height);
+        LOG_DEBUG("Window Aspect Ratio: {}", static_cast<float>(m_WindowProperties.m_Width) / static_cast<float>(m_WindowProperties.m_Height));
         m_WindowProperties.m_Width = mode->width;
         m_WindowProperties.m_Height = mode->height;
     }
@@ -67,23 +69,21 @@ void Window::Initialize(const InitializeWindowProps &props)
     glfwMakeContextCurrent(m_Window);
     SetVSync(m_WindowProperties.m_Vsync);
 
-    Logger::Info("OpenGL Vendor: {}", std::string(reinterpret_cast<const char *>(glGetString(GL_VENDOR))));
-    Logger::Info("OpenGL Renderer: {}", std::string(reinterpret_cast<const char *>(glGetString(GL_RENDERER))));
-    Logger::Info("OpenGL Version: {}", std::string(reinterpret_cast<const char *>(glGetString(GL_VERSION))));
+    Logger::Info("OpenGL Vendor: {}", std::string(reinterpret_cast<const char *>(GL_CALL(Other, glGetString(GL_VENDOR)))));
+    Logger::Info("OpenGL Renderer: {}", std::string(reinterpret_cast<const char *>(GL_CALL(Other, glGetString(GL_RENDERER)))));
+    Logger::Info("OpenGL Version: {}", std::string(reinterpret_cast<const char *>(GL_CALL(Other, glGetString(GL_VERSION)))));
+    if (!GLDebug::EnableDebugOutput() && GL_CALL_CHECKING)
+        LOG_DEBUG("KHR_debug unavailable, checking glGetError after every GL_CALL");
 
     // Set window properties on GLFW context to retrieve them in callbacks
     glfwSetWindowUserPointer(m_Window, &m_WindowProperties);
 
     // GLFW Callbacks
+    // events are only queued here, Application dispatches the whole batch at the start of the next frame
     // Window Close
     glfwSetWindowCloseCallback(
         m_Window, [](GLFWwindow *window)
-        {
-            WindowProperties &props = *(WindowProperties *)glfwGetWindowUserPointer(window);
-            WindowClosedEvent event;
-            // (hint: application's constructor will setEventCallback to its OnEvent method)
-            props.m_EventCallback(event); // Calls Application::OnEvent
-        });
+        { PushEvent(window, WindowClosedEvent()); });
 
     // Window Resize
     glfwSetWindowSizeCallback(
@@ -94,8 +94,7 @@ void Window::Initialize(const InitializeWindowProps &props)
             props.m_Width = width;
             props.m_Height = height;
 
-            WindowResizedEvent event(width, height);
-            props.m_EventCallback(event);
+            PushEvent(window, WindowResizedEvent(width, height));
         });
 
     // Key Press and Release
@@ -103,79 +102,66 @@ void Window::Initialize(const InitializeWindowProps &props)
         m_Window,
         [](GLFWwindow *window, int keycode, int scancode, int action, int mods)
         {
-            WindowProperties &props = *(WindowProperties *)glfwGetWindowUserPointer(window);
             switch (action)
             {
             case GLFW_PRESS:
-            {
-                KeyPressedEvent event(keycode, false); // Not a repeat
-                props.m_EventCallback(event);
+                PushEvent(window, KeyPressedEvent(keycode, false)); // Not a repeat
                 break;
-            }
             case GLFW_RELEASE:
-            {
-                KeyReleasedEvent event(keycode);
-                props.m_EventCallback(event);
+                PushEvent(window, KeyReleasedEvent(keycode));
                 break;
-            }
             case GLFW_REPEAT:
-            {
-                KeyPressedEvent event(keycode, true); // Repeat event
-                props.m_EventCallback(event);
+                PushEvent(window, KeyPressedEvent(keycode, true)); // Repeat event
                 break;
             }
-            }
         });
 
     // Mouse Movement
     glfwSetCursorPosCallback(
         m_Window,
         [](GLFWwindow *window, double xpos, double ypos)
-        {
-            WindowProperties &props = *(WindowProperties *)glfwGetWindowUserPointer(window);
-            MouseMovedEvent event(static_cast<float>(xpos), static_cast<float>(ypos));
-            props.m_EventCallback(event);
-        });
+        { PushEvent(window, MouseMovedEvent(static_cast<float>(xpos), static_cast<float>(ypos))); });
 
     // Mouse Button Press and Release
     glfwSetMouseButtonCallback(
         m_Window,
         [](GLFWwindow *window, int button, int action, int mods)
         {
-            WindowProperties &props = *(WindowProperties *)glfwGetWindowUserPointer(window);
             switch (action)
             {
             case GLFW_PRESS:
-            {
-                MouseButtonPressedEvent event(button);
-                props.m_EventCallback(event);
+                PushEvent(window, MouseButtonPressedEvent(button));
                 break;
-            }
             case GLFW_RELEASE:
-            {
-                MouseButtonReleasedEvent event(button);
-                props.m_EventCallback(event);
+                PushEvent(window, MouseButtonReleasedEvent(button));
                 break;
             }
-            }
         });
 
     // Mouse Scroll
     glfwSetScrollCallback(
         m_Window,
         [](GLFWwindow *window, double xOffset, double yOffset)
-        {
-            WindowProperties &props = *(WindowProperties *)glfwGetWindowUserPointer(window);
+        { PushEvent(window, MouseScrolledEvent(static_cast<float>(xOffset), static_cast<float>(yOffset))); });
+}
 
-            MouseScrolledEvent event(static_cast<float>(xOffset), static_cast<float>(yOffset));
-            props.m_EventCallback(event);
-        });
+void Window::PushEvent(GLFWwindow *window, const QueuedEvent &event)
+{
+    WindowProperties &props = *(WindowProperties *)glfwGetWindowUserPointer(window);
+    if (props.m_EventQueue)
+        props.m_EventQueue->Push(event);
 }
 
 void Window::OnUpdate()
 {
-    glfwSwapBuffers(m_Window);
-    glfwPollEvents();
+    {
+        PROFILE_SCOPE("glfwSwapBuffers");
+        glfwSwapBuffers(m_Window);
+    }
+    {
+        PROFILE_SCOPE("glfwPollEvents");
+        glfwPollEvents();
+    }
 }
 
 void Window::SetVSync(bool sync)
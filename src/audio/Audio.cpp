@@ -2,6 +2,8 @@
 #include "audio/MP3Decoder.hpp"
 #include <iostream>
 #include "Logger.hpp"
+#include "Profiler.hpp"
+#include "AllocationTracker.hpp"
 
 #define ERROR(x)         \
     Logger::Critical(x); \
@@ -79,6 +81,8 @@ void Audio::CleanupOpenAL()
 
 bool Audio::LoadAudio(const std::string &audioFilePath)
 {
+    PROFILE_FUNCTION();
+    AllocationScope allocationScope(AllocTag::Audio);
     MP3Decoder decoder;
     if (!decoder.Decode(audioFilePath))
     {
@@ -87,11 +91,17 @@ bool Audio::LoadAudio(const std::string &audioFilePath)
     }
 
     const PCMData &pcmData = decoder.GetDecodedPCMData();
-    Logger::Debug("MP3 Data:");
+    LOG_DEBUG("MP3 Data:");
     std::cout << decoder.GetMP3Data() << std::endl;
-    Logger::Debug("PCM Data:");
+    LOG_DEBUG("PCM Data:");
     std::cout << pcmData << std::endl;
 
+    return LoadPCM(pcmData);
+}
+
+bool Audio::LoadPCM(const PCMData &pcmData)
+{
+    PROFILE_FUNCTION();
     ALenum format = (pcmData.m_Channels == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
     alBufferData(m_Buffer, format, pcmData.m_Data.data(), pcmData.m_Data.size(), pcmData.m_SampleRate);
     if (alGetError() != AL_NO_ERROR)
@@ -2,6 +2,8 @@
 #include <mpg123.h>
 #include <stdexcept>
 #include "Logger.hpp"
+#include "Profiler.hpp"
+#include "AllocationTracker.hpp"
 
 #define ERROR(x)         \
     Logger::Critical(x); \
@@ -22,6 +24,8 @@ MP3Decoder::~MP3Decoder()
 
 bool MP3Decoder::Decode(const std::string &filePath)
 {
+    PROFILE_FUNCTION();
+    AllocationScope allocationScope(AllocTag::Audio);
     mpg123_handle *mh = mpg123_new(nullptr, nullptr);
     if (!mh)
     {
@@ -0,0 +1,111 @@
+#define GL_SILENCE_DEPRECATION
+
+#include <OpenGL/gl3.h>
+#include <stdexcept>
+#include "buffers/GBuffer.hpp"
+#include "GLCall.hpp"
+#include "Logger.hpp"
+
+static GLuint CreateAttachment(GLint internalFormat, GLenum format, GLenum type, int width, int height)
+{
+    GLuint texture;
+    GL_CALL(Texture, glGenTextures(1, &texture));
+    GL_CALL(Bind, glBindTexture(GL_TEXTURE_2D, texture));
+    GL_CALL(Texture, glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr));
+    GL_CALL(Texture, glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GL_CALL(Texture, glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    GL_CALL(Texture, glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    GL_CALL(Texture, glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    return texture;
+}
+
+GBuffer::GBuffer(int width, int height)
+    : m_FramebufferID(0), m_AlbedoTexture(0), m_NormalTexture(0), m_DepthTexture(0),
+      m_Width(width), m_Height(height)
+{
+    Invalidate();
+}
+
+GBuffer::~GBuffer()
+{
+    Release();
+}
+
+void GBuffer::Bind() const
+{
+    GL_CALL(Framebuffer, glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID));
+    GL_CALL(State, glViewport(0, 0, m_Width, m_Height));
+}
+
+void GBuffer::UnBind() const
+{
+    GL_CALL(Framebuffer, glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void GBuffer::Resize(int width, int height)
+{
+    if (width <= 0 || height <= 0 || (width == m_Width && height == m_Height))
+        return;
+
+    m_Width = width;
+    m_Height = height;
+    Invalidate();
+}
+
+void GBuffer::BindTextures(GLenum firstUnit) const
+{
+    GL_CALL(Bind, glActiveTexture(firstUnit));
+    GL_CALL(Bind, glBindTexture(GL_TEXTURE_2D, m_AlbedoTexture));
+    GL_CALL(Bind, glActiveTexture(firstUnit + 1));
+    GL_CALL(Bind, glBindTexture(GL_TEXTURE_2D, m_NormalTexture));
+    GL_CALL(Bind, glActiveTexture(firstUnit + 2));
+    GL_CALL(Bind, glBindTexture(GL_TEXTURE_2D, m_DepthTexture));
+    GL_CALL(Bind, glActiveTexture(GL_TEXTURE0));
+}
+
+void GBuffer::Invalidate()
+{
+    Release();
+
+    GL_CALL(Framebuffer, glGenFramebuffers(1, &m_FramebufferID));
+    GL_CALL(Framebuffer, glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID));
+
+    m_AlbedoTexture = CreateAttachment(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, m_Width, m_Height);
+    m_NormalTexture = CreateAttachment(GL_RGBA16F, GL_RGBA, GL_FLOAT, m_Width, m_Height);
+    m_DepthTexture = CreateAttachment(GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT, m_Width, m_Height);
+
+    GL_CALL(Framebuffer, glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_AlbedoTexture, 0));
+    GL_CALL(Framebuffer, glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, m_NormalTexture, 0));
+    GL_CALL(Framebuffer, glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_DepthTexture, 0));
+
+    GLenum drawBuffers[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    GL_CALL(Framebuffer, glDrawBuffers(2, drawBuffers));
+
+    if (GL_CALL(Framebuffer, glCheckFramebufferStatus(GL_FRAMEBUFFER)) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        Logger::Critical("GBuffer framebuffer is incomplete ({}x{})", m_Width, m_Height);
+        throw std::runtime_error("GBuffer framebuffer is incomplete");
+    }
+
+    GL_CALL(Framebuffer, glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    LOG_DEBUG("GBuffer created: {}x{}", m_Width, m_Height);
+}
+
+void GBuffer::Release()
+{
+    if (m_AlbedoTexture)
+        GL_CALL(Texture, glDeleteTextures(1, &m_AlbedoTexture));
+    if (m_NormalTexture)
+        GL_CALL(Texture, glDeleteTextures(1, &m_NormalTexture));
+    if (m_DepthTexture)
+        GL_CALL(Texture, glDeleteTextures(1, &m_DepthTexture));
+    if (m_FramebufferID)
+        GL_CALL(Framebuffer, glDeleteFramebuffers(1, &m_FramebufferID));
+
+    m_AlbedoTexture = m_NormalTexture = m_DepthTexture = m_FramebufferID = 0;
+}
+
+std::unique_ptr<GBuffer> GBuffer::Create(int width, int height)
+{
+    return std::make_unique<GBuffer>(width, height);
+}
@@ -2,31 +2,63 @@
 
 #include <OpenGL/gl3.h>
 #include "buffers/IndexBuffer.hpp"
+#include "GLCall.hpp"
 
 IndexBuffer::IndexBuffer(const std::vector<unsigned int> &vecIndexBufferData)
-    : m_IndexBufferID(0), m_Count(vecIndexBufferData.size())
+    : m_IndexBufferID(0), m_Count(vecIndexBufferData.size()), m_Capacity(vecIndexBufferData.size()), m_Dynamic(false)
 {
-    glGenBuffers(1, &m_IndexBufferID);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, vecIndexBufferData.size() * sizeof(unsigned int), vecIndexBufferData.data(), GL_STATIC_DRAW);
+    GL_CALL(Buffer, glGenBuffers(1, &m_IndexBufferID));
+    GL_CALL(Bind, glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID));
+    GL_CALL(Buffer, glBufferData(GL_ELEMENT_ARRAY_BUFFER, vecIndexBufferData.size() * sizeof(unsigned int), vecIndexBufferData.data(), GL_STATIC_DRAW));
+}
+
+IndexBuffer::IndexBuffer(uint32_t maxCount)
+    : m_IndexBufferID(0), m_Count(0), m_Capacity(maxCount), m_Dynamic(true)
+{
+    GL_CALL(Buffer, glGenBuffers(1, &m_IndexBufferID));
+    GL_CALL(Bind, glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID));
+    GL_CALL(Buffer, glBufferData(GL_ELEMENT_ARRAY_BUFFER, maxCount * sizeof(unsigned int), nullptr, GL_DYNAMIC_DRAW));
 }
 
 IndexBuffer::~IndexBuffer()
 {
-    glDeleteBuffers(1, &m_IndexBufferID);
+    GL_CALL(Buffer, glDeleteBuffers(1, &m_IndexBufferID));
 }
 
 void IndexBuffer::Bind() const
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID);
+    GL_CALL(Bind, glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID));
 }
 
 void IndexBuffer::UnBind() const
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GL_CALL(Bind, glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+}
+
+void IndexBuffer::SetData(const std::vector<unsigned int> &vecIndexBufferData)
+{
+    // GL_ELEMENT_ARRAY_BUFFER binding is VAO state, bind the owning VAO before calling this
+    GL_CALL(Bind, glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferID));
+
+    uint32_t count = vecIndexBufferData.size();
+    if (count > m_Capacity || !m_Dynamic)
+    {
+        m_Capacity = count;
+        m_Dynamic = true;
+    }
+
+    // orphan then upload, avoids waiting on draws still reading the old indices
+    GL_CALL(Buffer, glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_Capacity * sizeof(unsigned int), nullptr, GL_DYNAMIC_DRAW));
+    GL_CALL(Buffer, glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, count * sizeof(unsigned int), vecIndexBufferData.data()));
+    m_Count = count;
 }
 
 std::shared_ptr<IndexBuffer> IndexBuffer::Create(const std::vector<unsigned int> &vecIndexBufferData)
 {
     return std::make_shared<IndexBuffer>(vecIndexBufferData);
-}
\ No newline at end of file
+}
+
+std::shared_ptr<IndexBuffer> IndexBuffer::Create(uint32_t maxCount)
+{
+    return std::make_shared<IndexBuffer>(maxCount);
+}
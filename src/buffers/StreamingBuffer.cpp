@@ -0,0 +1,165 @@
+#define GL_SILENCE_DEPRECATION
+
+#include <OpenGL/gl3.h>
+#include <cstring>
+#include "buffers/StreamingBuffer.hpp"
+#include "GLCall.hpp"
+#include "Logger.hpp"
+
+// 1 second, fences normally signal within a frame or two
+static constexpr GLuint64 FENCE_TIMEOUT_NS = 1000000000;
+
+static bool SupportsBufferStorage()
+{
+#ifdef GL_MAP_PERSISTENT_BIT
+    GLint major = 0, minor = 0;
+    GL_CALL(Other, glGetIntegerv(GL_MAJOR_VERSION, &major));
+    GL_CALL(Other, glGetIntegerv(GL_MINOR_VERSION, &minor));
+    return major > 4 || (major == 4 && minor >= 4);
+#else
+    return false;
+#endif
+}
+
+StreamingBuffer::StreamingBuffer(GLenum target, GLsizeiptr frameCapacity, uint32_t frameCount)
+    : m_BufferID(0),
+      m_Target(target),
+      m_FrameCapacity(frameCapacity),
+      m_FrameCount(frameCount),
+      m_FrameIndex(0),
+      m_FrameHead(0),
+      m_Fences(frameCount, nullptr),
+      m_PersistentData(nullptr),
+      m_Mapped(false)
+{
+    if (frameCapacity <= 0 || frameCount == 0)
+    {
+        Logger::Critical("StreamingBuffer needs a non-zero capacity and frame count");
+        throw std::runtime_error("StreamingBuffer needs a non-zero capacity and frame count");
+    }
+
+    GLsizeiptr totalSize = m_FrameCapacity * m_FrameCount;
+    GL_CALL(Buffer, glGenBuffers(1, &m_BufferID));
+    GL_CALL(Bind, glBindBuffer(m_Target, m_BufferID));
+
+#ifdef GL_MAP_PERSISTENT_BIT
+    if (SupportsBufferStorage())
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GL_CALL(Buffer, glBufferStorage(m_Target, totalSize, nullptr, flags));
+        m_PersistentData = static_cast<unsigned char *>(GL_CALL(Buffer, glMapBufferRange(m_Target, 0, totalSize, flags)));
+    }
+#endif
+
+    if (!m_PersistentData)
+        GL_CALL(Buffer, glBufferData(m_Target, totalSize, nullptr, GL_STREAM_DRAW));
+
+    LOG_DEBUG("StreamingBuffer: {} x {} bytes ({})", m_FrameCount, m_FrameCapacity,
+              m_PersistentData ? "persistent" : "unsynchronized map");
+}
+
+StreamingBuffer::~StreamingBuffer()
+{
+    for (GLsync &fence : m_Fences)
+        if (fence)
+            GL_CALL(Buffer, glDeleteSync(fence));
+
+    if (m_PersistentData || m_Mapped)
+    {
+        GL_CALL(Bind, glBindBuffer(m_Target, m_BufferID));
+        GL_CALL(Buffer, glUnmapBuffer(m_Target));
+    }
+    GL_CALL(Buffer, glDeleteBuffers(1, &m_BufferID));
+}
+
+void StreamingBuffer::Bind() const
+{
+    GL_CALL(Bind, glBindBuffer(m_Target, m_BufferID));
+}
+
+void StreamingBuffer::UnBind() const
+{
+    GL_CALL(Bind, glBindBuffer(m_Target, 0));
+}
+
+void StreamingBuffer::BeginFrame()
+{
+    // the GPU may still be reading this region from m_FrameCount frames ago
+    WaitForFence(m_Fences[m_FrameIndex]);
+    m_FrameHead = 0;
+}
+
+void StreamingBuffer::EndFrame()
+{
+    if (m_Mapped)
+        Unmap();
+
+    m_Fences[m_FrameIndex] = GL_CALL(Buffer, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    m_FrameIndex = (m_FrameIndex + 1) % m_FrameCount;
+}
+
+StreamingAllocation StreamingBuffer::Map(GLsizeiptr size, GLsizeiptr alignment)
+{
+    if (m_Mapped)
+        Unmap();
+
+    GLsizeiptr alignedHead = (m_FrameHead + alignment - 1) / alignment * alignment;
+    if (alignedHead + size > m_FrameCapacity)
+    {
+        Logger::Critical("StreamingBuffer overflow: {} + {} > {} bytes", alignedHead, size, m_FrameCapacity);
+        throw std::runtime_error("StreamingBuffer overflow");
+    }
+
+    GLintptr offset = GetFrameBaseOffset() + alignedHead;
+    m_FrameHead = alignedHead + size;
+
+    if (m_PersistentData)
+        return {m_PersistentData + offset, offset, size};
+
+    // fences already guarantee this range is idle, so skip the driver's implicit sync
+    GL_CALL(Bind, glBindBuffer(m_Target, m_BufferID));
+    void *data = GL_CALL(Buffer, glMapBufferRange(m_Target, offset, size,
+                                  GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+    m_Mapped = data != nullptr;
+    return {data, offset, size};
+}
+
+void StreamingBuffer::Unmap()
+{
+    if (!m_Mapped)
+        return;
+
+    GL_CALL(Bind, glBindBuffer(m_Target, m_BufferID));
+    GL_CALL(Buffer, glUnmapBuffer(m_Target));
+    m_Mapped = false;
+}
+
+GLintptr StreamingBuffer::Upload(const void *data, GLsizeiptr size, GLsizeiptr alignment)
+{
+    StreamingAllocation allocation = Map(size, alignment);
+    if (allocation.m_Data)
+        std::memcpy(allocation.m_Data, data, size);
+    Unmap();
+    return allocation.m_Offset;
+}
+
+void StreamingBuffer::WaitForFence(GLsync &fence)
+{
+    if (!fence)
+        return;
+
+    GLenum result = GL_CALL(Buffer, glClientWaitSync(fence, 0, 0));
+    while (result == GL_TIMEOUT_EXPIRED)
+        result = GL_CALL(Buffer, glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS));
+
+    if (result == GL_WAIT_FAILED)
+        Logger::Warn("StreamingBuffer fence wait failed");
+
+    GL_CALL(Buffer, glDeleteSync(fence));
+    fence = nullptr;
+}
+
+std::shared_ptr<StreamingBuffer> StreamingBuffer::Create(GLenum target, GLsizeiptr frameCapacity, uint32_t frameCount)
+{
+    return std::make_shared<StreamingBuffer>(target, frameCapacity, frameCount);
+}
@@ -2,27 +2,28 @@
 
 #include <OpenGL/gl3.h>
 #include "buffers/VertexArray.hpp"
+#include "GLCall.hpp"
 
 VertexArray::VertexArray()
-    : m_VertexArrayID(0)
+    : m_VertexArrayID(0), m_VertexAttribIndex(0)
 {
-    glGenVertexArrays(1, &m_VertexArrayID);
-    glBindVertexArray(m_VertexArrayID);
+    GL_CALL(Buffer, glGenVertexArrays(1, &m_VertexArrayID));
+    GL_CALL(Bind, glBindVertexArray(m_VertexArrayID));
 }
 
 VertexArray::~VertexArray()
 {
-    glDeleteVertexArrays(1, &m_VertexArrayID);
+    GL_CALL(Buffer, glDeleteVertexArrays(1, &m_VertexArrayID));
 }
 
 void VertexArray::Bind() const
 {
-    glBindVertexArray(m_VertexArrayID);
+    GL_CALL(Bind, glBindVertexArray(m_VertexArrayID));
 }
 
 void VertexArray::UnBind() const
 {
-    glBindVertexArray(0);
+    GL_CALL(Bind, glBindVertexArray(0));
 }
 
 void VertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer> &vertexBuffer)
@@ -37,24 +38,71 @@ void VertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer> &vertexBuf
     Bind();
     vertexBuffer->Bind();
 
-    auto &layout = vertexBuffer->GetLayout();
-    int index = 0;
-    std::size_t offset = 0;
+    GLuint firstIndex = m_VertexAttribIndex;
+    m_VertexAttribIndex += SetAttributePointers(vertexBuffer->GetLayout(), firstIndex, 0);
+    LOG_DEBUG("Vertex Array attributes {}-{} (stride {}, divisor {})", firstIndex, m_VertexAttribIndex - 1,
+              vertexBuffer->GetLayout().GetStride(), vertexBuffer->GetLayout().GetDivisor());
+    m_VertexBuffersRefs.push_back(vertexBuffer);
+}
+
+void VertexArray::AddStreamingBuffer(const std::shared_ptr<StreamingBuffer> &streamingBuffer)
+{
+    if (!streamingBuffer->GetLayout().GetBufferElements().size())
+    {
+        Logger::Critical("Streaming buffer needs a layout");
+        throw std::runtime_error("Streaming buffer needs a layout");
+    }
+
+    Bind();
+    streamingBuffer->Bind();
+
+    GLuint firstIndex = m_VertexAttribIndex;
+    m_VertexAttribIndex += SetAttributePointers(streamingBuffer->GetLayout(), firstIndex, 0);
+    m_StreamingBuffers.push_back({streamingBuffer, firstIndex});
+}
+
+void VertexArray::SetStreamingOffset(const std::shared_ptr<StreamingBuffer> &streamingBuffer, GLintptr baseOffset)
+{
+    for (const auto &binding : m_StreamingBuffers)
+    {
+        if (binding.m_Buffer != streamingBuffer)
+            continue;
+
+        // attributes are already enabled with their divisors, only the pointers move
+        Bind();
+        streamingBuffer->Bind();
+        SetAttributePointers(streamingBuffer->GetLayout(), binding.m_FirstIndex, baseOffset, true);
+        return;
+    }
+    Logger::Warn("Streaming buffer is not attached to VertexArray {}", m_VertexArrayID);
+}
+
+GLuint VertexArray::SetAttributePointers(const BufferLayout &layout, GLuint firstIndex, GLintptr baseOffset,
+                                         bool pointersOnly)
+{
+    GLuint index = firstIndex;
     for (const auto &element : layout)
     {
-        Logger::Debug("Vertex Array Offset: {}", offset * BufferElement::GetSizeFromGLenum(element.m_OpenGLType));
-        glEnableVertexAttribArray(index);
-        glVertexAttribPointer(
-            index,
-            element.m_Count,
-            element.m_OpenGLType,
-            element.m_IsNormalized,
-            layout.GetStride(),
-            (const void *)(offset * BufferElement::GetSizeFromGLenum(element.m_OpenGLType)));
-        index++;
-        offset += element.m_Count;
+        // matrices are uploaded as consecutive column vectors
+        GLint columns = BufferElement::GetColumnCountFromType(element.m_Type);
+        GLint componentsPerColumn = element.m_Count / columns;
+        std::size_t columnSize = BufferElement::GetSizeFromAttribType(element.m_Type) / columns;
+
+        for (GLint column = 0; column < columns; column++)
+        {
+            const void *offset = (const void *)(baseOffset + element.m_Offset + column * columnSize);
+            if (!pointersOnly)
+                GL_CALL(Buffer, glEnableVertexAttribArray(index));
+            if (element.IsInteger())
+                GL_CALL(Buffer, glVertexAttribIPointer(index, componentsPerColumn, element.m_OpenGLType, layout.GetStride(), offset));
+            else
+                GL_CALL(Buffer, glVertexAttribPointer(index, componentsPerColumn, element.m_OpenGLType, element.m_IsNormalized, layout.GetStride(), offset));
+            if (!pointersOnly)
+                GL_CALL(Buffer, glVertexAttribDivisor(index, layout.GetDivisor()));
+            index++;
+        }
     }
-    m_VertexBuffersRefs.push_back(vertexBuffer);
+    return index - firstIndex;
 }
 
 void VertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer> &indexbuffer)
@@ -77,4 +125,4 @@ void VertexArray::SetIndexBuffer(const IndexBuffer &indexBuffer)
 std::shared_ptr<VertexArray> VertexArray::Create()
 {
     return std::make_shared<VertexArray>();
-}
\ No newline at end of file
+}
@@ -2,31 +2,83 @@
 
 #include <OpenGL/gl3.h>
 #include "buffers/VertexBuffer.hpp"
+#include "GLCall.hpp"
 
 VertexBuffer::VertexBuffer(const std::vector<float> &vecBufferData)
-    : m_VertexBufferID(0)
+    : m_VertexBufferID(0), m_Size(vecBufferData.size() * sizeof(float)), m_Usage(GL_STATIC_DRAW)
 {
-    glGenBuffers(1, &m_VertexBufferID);
-    glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
-    glBufferData(GL_ARRAY_BUFFER, vecBufferData.size() * sizeof(float), vecBufferData.data(), GL_STATIC_DRAW);
+    GL_CALL(Buffer, glGenBuffers(1, &m_VertexBufferID));
+    GL_CALL(Bind, glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID));
+    GL_CALL(Buffer, glBufferData(GL_ARRAY_BUFFER, m_Size, vecBufferData.data(), m_Usage));
+}
+
+VertexBuffer::VertexBuffer(uint32_t size)
+    : m_VertexBufferID(0), m_Size(size), m_Usage(GL_DYNAMIC_DRAW)
+{
+    GL_CALL(Buffer, glGenBuffers(1, &m_VertexBufferID));
+    GL_CALL(Bind, glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID));
+    GL_CALL(Buffer, glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, m_Usage));
 }
 
 VertexBuffer::~VertexBuffer()
 {
-    glDeleteBuffers(1, &m_VertexBufferID);
+    GL_CALL(Buffer, glDeleteBuffers(1, &m_VertexBufferID));
 }
 
 void VertexBuffer::Bind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID);
+    GL_CALL(Bind, glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID));
 }
 
 void VertexBuffer::UnBind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL_CALL(Bind, glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
+
+void VertexBuffer::SetData(const void *data, uint32_t size, uint32_t offset)
+{
+    GL_CALL(Bind, glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferID));
+
+    if (offset + size > m_Size)
+    {
+        // reallocate in place (vertex arrays keep pointing at this buffer ID), bytes before
+        // 'offset' survive through a temporary copy
+        GLuint keep = 0;
+        uint32_t keepSize = offset < m_Size ? offset : m_Size;
+        if (keepSize > 0)
+        {
+            GL_CALL(Buffer, glGenBuffers(1, &keep));
+            GL_CALL(Bind, glBindBuffer(GL_COPY_WRITE_BUFFER, keep));
+            GL_CALL(Buffer, glBufferData(GL_COPY_WRITE_BUFFER, keepSize, nullptr, GL_STREAM_COPY));
+            GL_CALL(Buffer, glCopyBufferSubData(GL_ARRAY_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, keepSize));
+        }
+
+        m_Size = offset + size;
+        m_Usage = GL_DYNAMIC_DRAW;
+        GL_CALL(Buffer, glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, m_Usage));
+
+        if (keep)
+        {
+            GL_CALL(Bind, glBindBuffer(GL_COPY_READ_BUFFER, keep));
+            GL_CALL(Buffer, glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, 0, 0, keepSize));
+            GL_CALL(Buffer, glDeleteBuffers(1, &keep));
+        }
+    }
+    else if (offset == 0 && size == m_Size)
+    {
+        // full rewrite: orphan the old storage so we don't stall on in-flight draws
+        GL_CALL(Buffer, glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, m_Usage));
+    }
+
+    GL_CALL(Buffer, glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
 }
 
 std::shared_ptr<VertexBuffer> VertexBuffer::Create(const std::vector<float> &vecBufferData)
 {
     return std::make_shared<VertexBuffer>(vecBufferData);
-}
\ No newline at end of file
+}
+
+std::shared_ptr<VertexBuffer> VertexBuffer::Create(uint32_t size)
+{
+    return std::make_shared<VertexBuffer>(size);
+}
@@ -0,0 +1,42 @@
+#include "events/EventQueue.hpp"
+#include <algorithm>
+
+std::string ToString(const QueuedEvent &event)
+{
+    return std::visit([](const auto &concrete)
+                      { return concrete.ToString(); },
+                      event);
+}
+
+EventQueue::EventQueue(std::size_t capacity)
+    : m_Coalesced(0),
+      m_LastDispatched(0),
+      m_LastCoalesced(0)
+{
+    m_Pending.reserve(capacity);
+    m_Dispatching.reserve(capacity);
+}
+
+void EventQueue::Push(const QueuedEvent &event)
+{
+    // only the latest cursor position / window size matters, clicks and keys in between keep their order
+    bool coalesces = std::holds_alternative<MouseMovedEvent>(event) || std::holds_alternative<WindowResizedEvent>(event);
+    if (coalesces && !m_Pending.empty() && m_Pending.back().index() == event.index())
+    {
+        m_Pending.back() = event;
+        m_Coalesced++;
+        return;
+    }
+    m_Pending.push_back(event);
+}
+
+void EventQueue::DiscardInput()
+{
+    auto isInput = [](const QueuedEvent &event)
+    {
+        return std::visit([](const auto &concrete)
+                          { return concrete.IsInCategory(Event::EventCategory::Input); },
+                          event);
+    };
+    m_Pending.erase(std::remove_if(m_Pending.begin(), m_Pending.end(), isInput), m_Pending.end());
+}
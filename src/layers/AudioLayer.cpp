@@ -1,7 +1,9 @@
 #include "layers/AudioLayer.hpp"
+#include "Application.hpp"
+#include "Logger.hpp"
 
 AudioLayer::AudioLayer()
-    : Layer("AudioLayer")
+    : Layer("AudioLayer"), m_AudioPath("assets/audio/space-ambient.mp3"), m_Decoded(false)
 {
 }
 
@@ -14,17 +16,35 @@ AudioLayer::~AudioLayer()
 void AudioLayer::OnAttach()
 {
     m_Audio = Audio::Create();
-    m_Audio->LoadAudio("assets/audio/space-ambient.mp3");
-    m_Audio->Loop();
-    m_Audio->Play();
+    m_Decoder = std::make_unique<MP3Decoder>();
+    Application::Get().GetJobSystem().SubmitBackground(&AudioLayer::DecodeJob, this, m_DecodeCounter, "DecodeAudio");
 }
 
 void AudioLayer::OnDetach()
 {
+    // the job writes into m_Decoder, it has to finish before the layer goes away
+    Application::Get().GetJobSystem().Wait(m_DecodeCounter);
 }
 
 void AudioLayer::OnUpdate(float deltaTime)
 {
+    if (!m_Decoder || !m_DecodeCounter.IsDone())
+        return;
+
+    if (m_Decoded && m_Audio->LoadPCM(m_Decoder->GetDecodedPCMData()))
+    {
+        m_Audio->Loop();
+        m_Audio->Play();
+    }
+    m_Decoder.reset(); // the PCM copy lives in the OpenAL buffer now
+}
+
+void AudioLayer::DecodeJob(void *data, uint32_t, uint32_t)
+{
+    auto *layer = static_cast<AudioLayer *>(data);
+    layer->m_Decoded = layer->m_Decoder->Decode(layer->m_AudioPath);
+    if (!layer->m_Decoded)
+        Logger::Error("Failed to decode {}", layer->m_AudioPath);
 }
 
 void AudioLayer::OnRender()
@@ -2,6 +2,8 @@
 #include "buffers/BufferLayout.hpp"
 #include <glm/glm.hpp>
 #include "Application.hpp"
+#include "FrameStats.hpp"
+#include "GLCall.hpp"
 
 ExampleLayer::ExampleLayer()
     : Layer("ExampleLayer", false)
@@ -14,7 +16,7 @@ ExampleLayer::~ExampleLayer()
 
 void ExampleLayer::OnAttach()
 {
-    glEnable(GL_DEPTH_TEST);
+    GL_CALL(State, glEnable(GL_DEPTH_TEST));
 
     std::vector<float> vertices = {
         // Positions         // Texture Coords
@@ -49,11 +51,9 @@ void ExampleLayer::OnAttach()
     m_VAO->AddVertexBuffer(m_VBO);
     m_VAO->SetIndexBuffer(m_EBO);
 
-    m_ShaderManager = ShaderManager::Create();
-    m_ShaderManager->AddShader("pyramid", "example_vertex_shader.glsl", "example_frag_shader.glsl");
-
-    m_TextureManager = TextureManager::Create();
-    m_TextureManager->AddTexture("pyramid", "earth.jpg");
+    ResourceManager &resources = Application::Get().GetResourceManager();
+    m_Shader = resources.LoadShader("example_vertex_shader.glsl", "example_frag_shader.glsl");
+    m_Texture = resources.LoadTexture("earth.jpg");
 
     m_Model = glm::mat4(1.0f);
     m_View = glm::lookAt(glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
@@ -66,6 +66,10 @@ void ExampleLayer::OnDetach()
     m_VAO->UnBind();
     m_VBO->UnBind();
     m_EBO->UnBind();
+
+    ResourceManager &resources = Application::Get().GetResourceManager();
+    resources.Release(m_Shader);
+    resources.Release(m_Texture);
 }
 
 void ExampleLayer::OnUpdate(float deltaTime)
@@ -74,8 +78,9 @@ void ExampleLayer::OnUpdate(float deltaTime)
 
 void ExampleLayer::OnRender()
 {
-    auto *pyramidShader = m_ShaderManager->GetShader("pyramid");
-    auto *pyramidTexture = m_TextureManager->GetTexture("pyramid");
+    ResourceManager &resources = Application::Get().GetResourceManager();
+    auto *pyramidShader = resources.Get(m_Shader);
+    auto *pyramidTexture = resources.Get(m_Texture);
     pyramidShader->UseProgram();
 
     // Add rotation to the model matrix
@@ -91,7 +96,8 @@ void ExampleLayer::OnRender()
     pyramidShader->UploadUniform1i("texture1", 0); // Explicitly set sampler to use unit 0
 
     m_VAO->Bind();
-    glDrawElements(GL_TRIANGLES, m_EBO->GetCount(), GL_UNSIGNED_INT, 0);
+    GL_CALL(Draw, glDrawElements(GL_TRIANGLES, m_EBO->GetCount(), GL_UNSIGNED_INT, 0));
+    FrameStats::CountDraw(GL_TRIANGLES, m_EBO->GetCount());
     m_VAO->UnBind();
 
     pyramidShader->UnBind();
@@ -1,11 +1,17 @@
 #include "layers/ImGuiOverlay.hpp"
 #include "Application.hpp"
+#include "Profiler.hpp"
+#include "FrameStats.hpp"
+#include "AllocationTracker.hpp"
 
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 #include "audio/OpenAL.hpp"
 #include "layers/AudioLayer.hpp"
+#include "layers/SolarSystem.hpp"
+#include "GLCall.hpp"
+#include <cstdio>
 
 ImGuiOverlay::ImGuiOverlay()
     : Layer("ImGuiOverlay"), m_Time(0.0f)
@@ -58,6 +64,8 @@ void ImGuiOverlay::OnUpdate(float deltaTime)
 
 void ImGuiOverlay::OnRender()
 {
+    AllocationScope allocationScope(AllocTag::UI);
+
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
@@ -66,10 +74,20 @@ void ImGuiOverlay::OnRender()
     ShowLayerManagementUI();
     ShowPerformanceMetrics();
     ShowGraphicsAndAudioInfo();
+    ShowRenderSettings();
 
     ImGui::EndFrame();
     ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+    GpuPassScope gpuPass(Application::Get().GetGpuProfiler(), "ImGui");
+    ImDrawData *drawData = ImGui::GetDrawData();
+    ImGui_ImplOpenGL3_RenderDrawData(drawData);
+
+    // the backend issues one glDrawElements per command
+    uint32_t drawCalls = 0;
+    for (int i = 0; i < drawData->CmdListsCount; i++)
+        drawCalls += drawData->CmdLists[i]->CmdBuffer.Size;
+    FrameStats::CountDrawCalls(drawCalls, drawData->TotalIdxCount / 3);
 }
 
 void ImGuiOverlay::ShowLayerManagementUI()
@@ -79,12 +97,15 @@ void ImGuiOverlay::ShowLayerManagementUI()
     auto &app = Application::Get();
     auto &layerStack = app.GetLayerStack();
 
-    for (Layer *layer : layerStack)
+    float totalMs = 0.0f;
+    for (const auto &owned : layerStack)
     {
+        Layer *layer = owned.get();
         bool isVisible = layer->IsVisible();
         if (ImGui::Checkbox(layer->GetName().c_str(), &isVisible))
         {
-            layer->SetVisibility(isVisible);
+            // takes effect next frame, this overlay is itself in the middle of the render loop
+            layerStack.SetVisibility(layer, isVisible);
 
             // Check if the layer is an AudioLayer
             if (auto *audioLayer = dynamic_cast<AudioLayer *>(layer))
@@ -99,25 +120,150 @@ void ImGuiOverlay::ShowLayerManagementUI()
                 }
             }
         }
+
+        const LayerTiming &timing = layer->GetTiming();
+        ImGui::SameLine();
+        if (layer->IsVisible())
+            ImGui::Text("update %.3f  render %.3f ms", timing.averageUpdateMs, timing.averageRenderMs);
+        else
+            ImGui::TextDisabled("hidden");
+        totalMs += timing.averageUpdateMs + timing.averageRenderMs;
     }
+    ImGui::Separator();
+    ImGui::Text("%zu active layers, %.3f ms", layerStack.GetActiveLayers().size(), totalMs);
     ImGui::End();
 }
 
 void ImGuiOverlay::ShowPerformanceMetrics()
 {
-    float fps = 1.0f / m_Time;
+    auto &frameStats = Application::Get().GetFrameStats();
+    const FrameSample &last = frameStats.GetLastSample();
+    float averageMs = frameStats.GetAverageFrameMs();
+
     ImGui::Begin("Performance Metrics");
-    ImGui::Text("FPS: %.2f", fps);
+    ImGui::Text("FPS: %.2f (avg over %u frames)", averageMs > 0.0f ? 1000.0f / averageMs : 0.0f, frameStats.GetSampleCount());
     ImGui::Text("Delta Time: %.3f ms", m_Time.GetMilliSeconds());
+    ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f ms", frameStats.GetP50(), frameStats.GetP95(), frameStats.GetP99());
+    ImGui::Text("CPU %.2f ms  GPU %.2f ms", last.cpuMs, last.gpuMs);
+    ImGui::Text("Draw Calls: %u  Triangles: %u  Uniforms: %u", last.drawCalls, last.triangles, last.uniformUploads);
+    const EventQueue &events = Application::Get().GetEventQueue();
+    ImGui::Text("Events: %u dispatched, %u coalesced", events.GetLastDispatchedCount(), events.GetLastCoalescedCount());
+
+    const auto &frameTimes = frameStats.GetFrameTimes();
+    ImGui::PlotLines("##frameTimes", frameTimes.data(), static_cast<int>(frameTimes.size()),
+                     static_cast<int>(frameStats.GetHistoryOffset()), "frame time (ms)", 0.0f,
+                     frameStats.GetHistogramRangeMs(), ImVec2(0.0f, 60.0f));
+
+    const auto &histogram = frameStats.GetHistogram();
+    ImGui::PlotHistogram("##histogram", histogram.data(), static_cast<int>(histogram.size()), 0,
+                         "distribution", 0.0f, static_cast<float>(frameStats.GetSampleCount()) * 0.5f, ImVec2(0.0f, 60.0f));
+
+    float budget = frameStats.GetHitchBudget();
+    if (ImGui::SliderFloat("Hitch Budget (ms)", &budget, 4.0f, 100.0f))
+        frameStats.SetHitchBudget(budget);
+    ImGui::Text("Hitches: %u", frameStats.GetHitchCount());
+
+    // GPU results lag a few frames behind, the queries are never waited on
+    auto &gpuProfiler = Application::Get().GetGpuProfiler();
+    if (ImGui::CollapsingHeader("GPU Passes", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        for (std::size_t pass = 0; pass < gpuProfiler.GetPassCount(); pass++)
+        {
+            GpuPassStats stats = gpuProfiler.GetPassStats(pass);
+            const auto &history = gpuProfiler.GetPassHistory(pass);
+            ImGui::Text("%-8s %.3f ms (avg %.3f, max %.3f)", gpuProfiler.GetPassName(pass).c_str(),
+                        stats.lastMs, stats.averageMs, stats.maxMs);
+            ImGui::PushID(static_cast<int>(pass));
+            ImGui::PlotLines("##history", history.data(), static_cast<int>(history.size()),
+                             static_cast<int>(gpuProfiler.GetHistoryOffset()), nullptr, 0.0f, stats.maxMs * 1.2f,
+                             ImVec2(0.0f, 30.0f));
+            ImGui::PopID();
+        }
+
+        if (ImGui::Button("Dump GPU Timings"))
+            gpuProfiler.DumpToFile("gpu_timings.csv");
+    }
+
+    if (ImGui::CollapsingHeader("GL Calls"))
+    {
+        if (GLCallStats::IsEnabled())
+        {
+            const auto &counters = GLCallStats::GetLastFrame();
+            uint64_t total = 0;
+            for (std::size_t i = 0; i < counters.size(); i++)
+            {
+                ImGui::Text("%-12s %llu", GLCallCategoryName(static_cast<GLCallCategory>(i)),
+                            static_cast<unsigned long long>(counters[i]));
+                total += counters[i];
+            }
+            ImGui::Text("%-12s %llu", "Total", static_cast<unsigned long long>(total));
+        }
+        else
+            ImGui::TextUnformatted("Disabled in this build (premake5 --gl-stats)");
+    }
+
+    if (ImGui::CollapsingHeader("Allocations"))
+    {
+        const auto &counters = AllocationTracker::GetLastFrame();
+        AllocCounters total = AllocationTracker::GetLastFrameTotal();
+        for (std::size_t i = 0; i < counters.size(); i++)
+            ImGui::Text("%-10s %llu allocs, %llu bytes", AllocTagName(static_cast<AllocTag>(i)),
+                        static_cast<unsigned long long>(counters[i].allocations),
+                        static_cast<unsigned long long>(counters[i].bytes));
+        ImGui::Text("%-10s %llu allocs, %llu frees", "Frame", static_cast<unsigned long long>(total.allocations),
+                    static_cast<unsigned long long>(total.frees));
+        AllocCounters background = AllocationTracker::GetLastBackgroundTotal();
+        ImGui::Text("%-10s %llu allocs, %llu bytes", "Other thr.",
+                    static_cast<unsigned long long>(background.allocations),
+                    static_cast<unsigned long long>(background.bytes));
+        ImGui::Text("Live allocations: %llu", static_cast<unsigned long long>(AllocationTracker::GetLiveAllocations()));
+
+        const LinearArena &arena = Application::Get().GetFrameArena().GetCurrent();
+        ImGui::Text("Frame arena: %.1f / %.1f KB (peak %.1f KB)", arena.GetUsed() / 1024.0f,
+                    arena.GetCapacity() / 1024.0f, arena.GetPeak() / 1024.0f);
+    }
+
+    // busy share of the last frame per thread, the CPU trace shows the individual jobs
+    if (ImGui::CollapsingHeader("Jobs"))
+    {
+        const auto &threads = Application::Get().GetJobSystem().GetThreadStats();
+        for (std::size_t i = 0; i < threads.size(); i++)
+        {
+            char label[64];
+            std::snprintf(label, sizeof(label), "%u jobs, %u stolen", threads[i].jobs, threads[i].steals);
+            ImGui::ProgressBar(threads[i].utilization, ImVec2(120.0f, 0.0f), label);
+            ImGui::SameLine();
+            if (i == 0)
+                ImGui::TextUnformatted("Main");
+            else
+                ImGui::Text("Worker %zu", i);
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Resources"))
+    {
+        const ResourceManager &resources = Application::Get().GetResourceManager();
+        ImGui::Text("VRAM: %.1f / %.1f MB", resources.GetVramUsed() / (1024.0f * 1024.0f),
+                    resources.GetVramBudget() / (1024.0f * 1024.0f));
+        ImGui::Text("Pending: %u  Evictions: %u", resources.GetPendingCount(), resources.GetEvictionCount());
+        resources.GetTextureInfo(m_TextureRows);
+        for (const TextureInfo &row : m_TextureRows)
+            ImGui::Text("%-8s %2u refs %7.1f KB %s%s", ResourceStateName(row.state), row.references,
+                        row.bytes / 1024.0f, row.path->c_str(), row.alias ? " (shared)" : "");
+    }
+
+    // open in chrome://tracing or ui.perfetto.dev
+    if (ImGui::Button("Save CPU Trace"))
+        Profiler::WriteChromeTrace("cpu_trace.json");
     ImGui::End();
 }
 
 void ImGuiOverlay::ShowGraphicsAndAudioInfo()
 {
     // Retrieve grphics information
-    const GLubyte *renderer = glGetString(GL_RENDERER);
-    const GLubyte *version = glGetString(GL_VERSION);
-    const GLubyte *vendor = glGetString(GL_VENDOR);
+    const GLubyte *renderer = GL_CALL(Other, glGetString(GL_RENDERER));
+    const GLubyte *version = GL_CALL(Other, glGetString(GL_VERSION));
+    const GLubyte *vendor = GL_CALL(Other, glGetString(GL_VENDOR));
     const ALbyte *alVersion = alGetString(AL_VERSION);
 
     ImGui::Begin("Graphics and Audio Info");
@@ -128,6 +274,31 @@ void ImGuiOverlay::ShowGraphicsAndAudioInfo()
     ImGui::End();
 }
 
+void ImGuiOverlay::ShowRenderSettings()
+{
+    ImGui::Begin("Render Settings");
+
+    for (const auto &layer : Application::Get().GetLayerStack())
+    {
+        auto *solarSystem = dynamic_cast<SolarSystemLayer *>(layer.get());
+        if (!solarSystem)
+            continue;
+
+        auto &settings = solarSystem->GetRenderSettings();
+        ImGui::Checkbox("Sphere Impostors", &settings.impostors);
+        ImGui::SliderFloat("Impostor Threshold (px)", &settings.impostorPixelThreshold, 0.0f, 128.0f);
+        ImGui::Checkbox("Deferred Shading", &settings.deferredShading);
+        ImGui::SliderInt("Point Lights", &settings.pointLightCount, 0, static_cast<int>(solarSystem->GetMaxPointLights()));
+
+        ImGui::Separator();
+        ImGui::Checkbox("Skybox Last", &settings.skyboxLast);
+        ImGui::Checkbox("Depth Pre-pass", &settings.depthPrePass);
+        ImGui::Text("Skybox Samples: %llu", static_cast<unsigned long long>(solarSystem->GetSkyboxSamples()));
+        ImGui::Text("Body Samples: %llu", static_cast<unsigned long long>(solarSystem->GetBodySamples()));
+    }
+    ImGui::End();
+}
+
 void ImGuiOverlay::ShowDockingSpace()
 {
     ImGuiIO &io = ImGui::GetIO();
@@ -1,10 +1,24 @@
 #include "layers/SolarSystem.hpp"
 #include "buffers/BufferLayout.hpp"
+#include "GLCall.hpp"
 #include "Logger.hpp"
 #include "Application.hpp"
+#include "FrameStats.hpp"
+#include "BinaryLog.hpp"
 
-SolarSystemLayer::SolarSystemLayer()
+// per-impostor attributes, one instance per draw, see the layout in OnAttach
+struct ImpostorInstance
+{
+    glm::vec4 centerRadius;
+    glm::mat3 rotation; // rotation only, used to bring hit normals back into texture space
+    int isSun;
+};
+
+SolarSystemLayer::SolarSystemLayer(bool proceduralGeometry)
     : Layer("SolarSystemLayerLayer"), m_Time(0.0f), m_OrbitalSpeedScale(0.05f),
+      m_ProceduralGeometry(proceduralGeometry),
+      m_BodyDraws(FrameAllocator<BodyDrawCommand>(Application::Get().GetFrameArena())),
+      m_ImpostorDraws(FrameAllocator<BodyDrawCommand>(Application::Get().GetFrameArena())),
       m_CelestialBodies{
           {glm::vec3(0.0f, 0.0f, -20.0f), 50.0f, 2.0f, 7.25f, 0.0f, 0.0f},         // Sun
           {glm::vec3(0.0f, 0.0f, -50.0f), 0.38f, 10.0f, 0.03f, 30.0f, 47.87f},     // Mercury
@@ -18,18 +32,18 @@ SolarSystemLayer::SolarSystemLayer()
           {glm::vec3(0.0f, 2.0f, -210.0f), 0.18f, 5.0f, 122.5f, 180.0f, 4.74f}     // Pluto
       }
 {
-    Logger::Debug("{} Added", m_DebugName);
+    LOG_DEBUG("{} Added", m_DebugName);
 }
 
 SolarSystemLayer::~SolarSystemLayer()
 {
-    Logger::Debug("{} Removed", m_DebugName);
+    LOG_DEBUG("{} Removed", m_DebugName);
 }
 
 void SolarSystemLayer::OnAttach()
 {
-    Logger::Debug("{} Attached", m_DebugName);
-    glEnable(GL_DEPTH_TEST);
+    LOG_DEBUG("{} Attached", m_DebugName);
+    GL_CALL(State, glEnable(GL_DEPTH_TEST));
 
     // Skybox cube vertices (6 faces)
     std::vector<float> skyboxVertices = {
@@ -81,50 +95,19 @@ void SolarSystemLayer::OnAttach()
     m_SkyboxVBO->SetLayout({{BufferAttributeType::Vec3, "aPos"}});
     m_SkyboxVAO->AddVertexBuffer(m_SkyboxVBO);
 
-    // Generate sphere data and orbit line
-    GenerateSphere(m_SphereVertices, m_SphereIndices, 0.5f, 36, 18);
-    for (const auto &body : m_CelestialBodies)
-    {
-        // 100 segments for a smooth circle
-        GenerateOrbitLine(m_OrbitLineVertices, body.orbitalRadius, 100);
-    }
-
-    // orbit line layout, vertex buffer, and vertex array
-    BufferLayout orbitLayout = {{BufferAttributeType::Vec3, "aPos"}};
-
-    m_OrbitVAO = VertexArray::Create();
-    m_OrbitVBO = VertexBuffer::Create(m_OrbitLineVertices);
-    m_OrbitVBO->SetLayout(orbitLayout);
-    m_OrbitVAO->AddVertexBuffer(m_OrbitVBO);
-
-    BufferLayout layout = {
-        {BufferAttributeType::Vec3, "aPos"},
-        {BufferAttributeType::Vec3, "aNormal"},
-        {BufferAttributeType::Vec2, "aTexCoords"},
-    };
-
-    m_VAO = VertexArray::Create();
-    m_VBO = VertexBuffer::Create(m_SphereVertices);
-    m_EBO = IndexBuffer::Create(m_SphereIndices);
-    m_VBO->SetLayout(layout);
-    m_VAO->AddVertexBuffer(m_VBO);
-    m_VAO->SetIndexBuffer(m_EBO);
+    // Sphere and orbit geometry, either uploaded from the CPU or generated from gl_VertexID
+    if (m_ProceduralGeometry)
+        CreateProceduralGeometry();
+    else
+        CreateMeshGeometry();
 
     // Load textures for celestial bodies
-    m_TextureManager = TextureManager::Create();
-    m_TextureManager->AddTexture("sun", "sun.jpg");
-    m_TextureManager->AddTexture("mercury", "mercury.jpg");
-    m_TextureManager->AddTexture("venus", "venus.jpeg");
-    m_TextureManager->AddTexture("earth", "earth.jpg");
-    m_TextureManager->AddTexture("mars", "mars.jpg");
-    m_TextureManager->AddTexture("jupiter", "jupiter.jpg");
-    m_TextureManager->AddTexture("saturn", "saturn.jpg");
-    m_TextureManager->AddTexture("uranus", "uranus.jpg");
-    m_TextureManager->AddTexture("neptune", "neptune.jpg");
-    m_TextureManager->AddTexture("pluto", "pluto.jpg");
-    m_TextureManager->AddTexture("moon", "moon.jpg");
-
-    m_TextureNames = m_TextureManager->GetTextureNames();
+    // decoded on the job system, bodies draw with a placeholder until their upload lands
+    ResourceManager &resources = Application::Get().GetResourceManager();
+    for (const char *file : {"sun.jpg", "mercury.jpg", "venus.jpeg", "earth.jpg", "mars.jpg",
+                             "jupiter.jpg", "saturn.jpg", "uranus.jpg", "neptune.jpg", "pluto.jpg"})
+        m_BodyTextures.push_back(resources.LoadTexture(file));
+    m_MoonTexture = resources.LoadTexture("moon.jpg");
 
     // Skybox cubemap
     std::vector<std::string> cubemapFaces = {
@@ -135,55 +118,146 @@ void SolarSystemLayer::OnAttach()
         "assets/cubemaps/faces/starmap_4k/pz.png", // Positive Z
         "assets/cubemaps/faces/starmap_4k/nz.png"  // Negative Z
     };
-    m_CubemapTexture = std::make_unique<Texture>(cubemapFaces);
+    m_CubemapTexture = std::make_unique<Texture>(cubemapFaces, &Application::Get().GetJobSystem());
 
     // Load shaders
-    m_ShaderManager = ShaderManager::Create();
-    m_ShaderManager->AddShader("SolarSystemPhong", "phong_vertex_shader.glsl", "phong_frag_shader.glsl");
-    m_ShaderManager->AddShader("SolarSystemGouraud", "gouraud_vertex_shader.glsl", "gouraud_frag_shader.glsl");
-    m_ShaderManager->AddShader("SolarSystemFlat", "flat_vertex_shader.glsl", "flat_frag_shader.glsl");
-    m_ShaderManager->AddShader("OrbitLine", "orbitline_vertex_shader.glsl", "orbitline_frag_shader.glsl");
-    m_ShaderManager->AddShader("Skybox", "skybox_vertex_shader.glsl", "skybox_frag_shader.glsl");
+    const char *bodyVertexShader = m_ProceduralGeometry ? "phong_procedural_vertex_shader.glsl" : "phong_vertex_shader.glsl";
+    m_Shaders[PHONG_SHADER] = resources.LoadShader(bodyVertexShader, "phong_frag_shader.glsl");
+    m_Shaders[GBUFFER_SHADER] = resources.LoadShader(bodyVertexShader, "gbuffer_frag_shader.glsl");
+    m_Shaders[DEPTH_SHADER] = resources.LoadShader(bodyVertexShader, "depth_only_frag_shader.glsl");
+    m_Shaders[GOURAUD_SHADER] = resources.LoadShader("gouraud_vertex_shader.glsl", "gouraud_frag_shader.glsl");
+    m_Shaders[FLAT_SHADER] = resources.LoadShader("flat_vertex_shader.glsl", "flat_frag_shader.glsl");
+    if (m_ProceduralGeometry)
+        m_Shaders[ORBIT_SHADER] = resources.LoadShader("orbitline_procedural_vertex_shader.glsl", "orbitline_frag_shader.glsl");
+    else
+        m_Shaders[ORBIT_SHADER] = resources.LoadShader("orbitline_vertex_shader.glsl", "orbitline_frag_shader.glsl");
+    m_Shaders[SKYBOX_SHADER] = resources.LoadShader("skybox_vertex_shader.glsl", "skybox_frag_shader.glsl");
+    m_Shaders[IMPOSTOR_SHADER] = resources.LoadShader("impostor_vertex_shader.glsl", "impostor_frag_shader.glsl");
+
+    m_Shaders[DEFERRED_LIGHTING_SHADER] = resources.LoadShader("deferred_lighting_vertex_shader.glsl", "deferred_lighting_frag_shader.glsl");
+
+    // fullscreen passes are built from gl_VertexID, core profile still needs a VAO bound
+    m_EmptyVAO = VertexArray::Create();
+
+    // room for every body plus the moon each frame, triple buffered so the GPU can lag behind
+    m_ImpostorInstances = StreamingBuffer::Create(GL_ARRAY_BUFFER, (m_CelestialBodies.size() + 1) * sizeof(ImpostorInstance));
+    m_ImpostorInstances->SetLayout(BufferLayout(
+        {
+            {BufferAttributeType::Vec4, "aCenterRadius"},
+            {BufferAttributeType::Mat3, "aRotation"},
+            {BufferAttributeType::iVec, "aIsSun"},
+        },
+        1));
+    m_ImpostorVAO = VertexArray::Create();
+    m_ImpostorVAO->AddStreamingBuffer(m_ImpostorInstances);
 
     m_Model = glm::mat4(1.0f);
     m_View = m_Camera.GetViewMatrix();
     m_Projection = glm::perspective(
-        glm::radians(60.0f), Application::Get().GetWindow().GetAspectRatio(), 0.1f, 1000.0f);
+        glm::radians(60.0f), Application::Get().GetWindow().GetAspectRatio(), NEAR_PLANE, FAR_PLANE);
     m_LightPosition = m_CelestialBodies.at(0).position;
     m_LightColor = glm::vec3(1.0f, 1.0f, 0.8f); // Bright white-yellow light
+
+    // deferred shading targets follow the framebuffer (not window) size, they differ on Retina displays
+    GLint viewport[4];
+    GL_CALL(Other, glGetIntegerv(GL_VIEWPORT, viewport));
+    m_GBuffer = GBuffer::Create(viewport[2], viewport[3]);
+    m_LightGrid = std::make_unique<LightGrid>();
+    m_LightClusters = std::make_unique<LightGrid>(64, 16);
+    m_LightClusters->SetDepthRange(NEAR_PLANE, FAR_PLANE);
+    GeneratePointLights(256);
+
+    m_SkyboxSamples = std::make_unique<QueryRing>(GL_SAMPLES_PASSED);
+    m_BodySamples = std::make_unique<QueryRing>(GL_SAMPLES_PASSED);
 }
 
 void SolarSystemLayer::OnDetach()
 {
-    Logger::Debug("{} Detached", m_DebugName);
+    LOG_DEBUG("{} Detached", m_DebugName);
     m_VBO->UnBind();
-    m_EBO->UnBind();
+    if (m_EBO)
+        m_EBO->UnBind();
     m_VAO->UnBind();
+
+    ResourceManager &resources = Application::Get().GetResourceManager();
+    for (TextureHandle texture : m_BodyTextures)
+        resources.Release(texture);
+    m_BodyTextures.clear();
+    resources.Release(m_MoonTexture);
+    for (ShaderHandle &shader : m_Shaders)
+        resources.Release(shader);
+}
+
+Shader *SolarSystemLayer::GetShader(SolarSystemShader shader) const
+{
+    return Application::Get().GetResourceManager().Get(m_Shaders[shader]);
 }
 
 void SolarSystemLayer::OnUpdate(float deltaTime)
 {
     m_Time += deltaTime;
-    m_Camera.ProcessInput();
+    // a benchmark camera path replaces user input so every run flies the same route
+    const Benchmark *benchmark = Application::Get().GetBenchmark();
+    if (benchmark && benchmark->GetCameraPath())
+    {
+        CameraPose pose = benchmark->GetCameraPath()->Evaluate(benchmark->GetCameraPathTime());
+        m_Camera.SetPose(pose.position, pose.yaw, pose.pitch);
+    }
+    else
+        m_Camera.ProcessInput(Application::Get().GetInput(), deltaTime);
+    UpdatePointLights();
 }
 
-void SolarSystemLayer::OnEvent(Event &event)
+void SolarSystemLayer::OnRender()
 {
-    // EventDispatcher dispatcher(event);
-    // dispatcher.Dispatch<MouseMovedEvent>([this](MouseMovedEvent &e)
-    //                                      { return OnMouseMove(e); });
+    m_View = m_Camera.GetViewMatrix();
+    BuildBodyDrawCommands();
+    LOG_BINARY(spdlog::level::debug, "bodies {} impostors {} point lights {}", m_BodyDraws.size(),
+               m_ImpostorDraws.size(), GetActivePointLightCount());
+
+    // skybox-first shades every sky pixel and lets bodies overdraw it, kept to compare sample counts
+    if (!m_RenderSettings.skyboxLast)
+        DrawSkybox();
+
+    {
+        GpuPassScope gpuPass(Application::Get().GetGpuProfiler(), "Bodies");
+
+        // depth only, kept outside the sample query so counts reflect shaded fragments
+        if (m_RenderSettings.depthPrePass && !m_RenderSettings.deferredShading)
+            RenderDepthPrePass();
 
-    m_Camera.ProcessInput();
+        // opaque bodies first so the depth buffer rejects hidden orbit and skybox fragments
+        m_BodySamples->Begin();
+        if (m_RenderSettings.deferredShading)
+        {
+            RenderGeometryPass();
+            RenderLightingPass();
+        }
+        else
+            DrawBodies();
+        if (!m_ImpostorDraws.empty())
+            DrawImpostors();
+        m_BodySamples->End();
+    }
+
+    DrawOrbits();
+
+    if (m_RenderSettings.skyboxLast)
+        DrawSkybox();
+
+    m_BodySamples->Poll();
+    m_SkyboxSamples->Poll();
 }
 
-void SolarSystemLayer::OnRender()
+void SolarSystemLayer::DrawSkybox()
 {
-    m_View = m_Camera.GetViewMatrix();
-    // 3. Render the skybox
-    glDepthFunc(GL_LEQUAL); // Render skybox behind everything
-    glDepthMask(GL_FALSE);  // Disable depth writing
+    GpuPassScope gpuPass(Application::Get().GetGpuProfiler(), "Skybox");
+
+    // the vertex shader puts the skybox on the far plane, LEQUAL lets it pass against the cleared depth
+    GL_CALL(State, glDepthFunc(GL_LEQUAL));
+    GL_CALL(State, glDepthMask(GL_FALSE));
 
-    auto *skyboxShader = m_ShaderManager->GetShader("Skybox");
+    auto *skyboxShader = GetShader(SKYBOX_SHADER);
     skyboxShader->UseProgram();
 
     // Strip translation from the view matrix for the skybox
@@ -192,42 +266,76 @@ void SolarSystemLayer::OnRender()
     skyboxShader->UploadUniformMat4("projection", m_Projection);
 
     // Bind the cubemap texture and draw the skybox
+    m_SkyboxSamples->Begin();
     m_CubemapTexture->Bind(GL_TEXTURE0);
     m_SkyboxVAO->Bind();
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    GL_CALL(Draw, glDrawArrays(GL_TRIANGLES, 0, 36));
+    FrameStats::CountDraw(GL_TRIANGLES, 36);
     m_SkyboxVAO->UnBind();
+    m_SkyboxSamples->End();
 
     skyboxShader->UnBind();
 
     // Re-enable depth writing and reset depth function
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
+    GL_CALL(State, glDepthMask(GL_TRUE));
+    GL_CALL(State, glDepthFunc(GL_LESS));
+}
+
+void SolarSystemLayer::DrawOrbits()
+{
+    GpuPassScope gpuPass(Application::Get().GetGpuProfiler(), "Orbits");
 
-    auto *orbitShader = m_ShaderManager->GetShader("OrbitLine");
+    auto *orbitShader = GetShader(ORBIT_SHADER);
 
     orbitShader->UseProgram();
     orbitShader->UploadUniformMat4("view", m_View);
     orbitShader->UploadUniformMat4("projection", m_Projection);
     orbitShader->UploadUniform3f("orbitColor", glm::vec3(0.3f, 0.3f, 0.3f));
-    std::size_t offset = 0; // orbit line vertices offsets
+    orbitShader->UploadUniformMat4("model", glm::mat4(1.0f)); // orbits are already in world space
+
+    // all orbit strips in one call, regardless of body count
+    m_OrbitVAO->Bind();
+    if (m_ProceduralGeometry)
+        GL_CALL(Draw, glDrawArraysInstanced(GL_LINE_STRIP, 0, ORBIT_SEGMENTS + 1, static_cast<GLsizei>(m_CelestialBodies.size())));
+    else
+        GL_CALL(Draw, glMultiDrawArrays(GL_LINE_STRIP, m_OrbitFirsts.data(), m_OrbitCounts.data(), static_cast<GLsizei>(m_OrbitCounts.size())));
+    // one strip per body either way
+    FrameStats::CountDraw(GL_LINE_STRIP, ORBIT_SEGMENTS + 1, static_cast<GLsizei>(m_CelestialBodies.size()));
+    m_OrbitVAO->UnBind();
 
-    for (const auto &body : m_CelestialBodies)
-    {
-        glm::mat4 model = glm::mat4(1.0f);
-        orbitShader->UploadUniformMat4("model", model);
+    orbitShader->UnBind();
+}
+
+void SolarSystemLayer::RenderDepthPrePass()
+{
+    auto *shader = GetShader(DEPTH_SHADER);
+    shader->UseProgram();
+    shader->UploadUniformMat4("view", m_View);
+    shader->UploadUniformMat4("projection", m_Projection);
 
-        m_OrbitVAO->Bind();
-        glDrawArrays(GL_LINE_STRIP, offset, 101);
-        offset += 101;
-        m_OrbitVAO->UnBind();
+    GL_CALL(State, glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE));
+    for (const auto &draw : m_BodyDraws)
+    {
+        shader->UploadUniformMat4("model", draw.model);
+        DrawSphere();
     }
+    GL_CALL(State, glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
 
-    orbitShader->UnBind();
+    shader->UnBind();
+}
+
+void SolarSystemLayer::DrawBodies()
+{
+    // after a pre-pass only the front-most fragment of each pixel runs the Phong shader
+    if (m_RenderSettings.depthPrePass)
+    {
+        GL_CALL(State, glDepthFunc(GL_LEQUAL));
+        GL_CALL(State, glDepthMask(GL_FALSE));
+    }
 
-    auto *shader = m_ShaderManager->GetShader("SolarSystemPhong");
+    auto *shader = GetShader(PHONG_SHADER);
 
     shader->UseProgram();
-    shader->UploadUniformMat4("model", m_Model);
     shader->UploadUniformMat4("view", m_View);
     shader->UploadUniformMat4("projection", m_Projection);
 
@@ -235,6 +343,72 @@ void SolarSystemLayer::OnRender()
     shader->UploadUniform3f("viewPos", m_Camera.GetPosition());
     shader->UploadUniform3f("lightColor", m_LightColor);
 
+    // clustered point lights, each fragment only loops over the lights of its froxel
+    GLint viewport[4];
+    GL_CALL(Other, glGetIntegerv(GL_VIEWPORT, viewport));
+    m_LightClusters->Build(m_PointLights.data(), GetActivePointLightCount(), m_View, m_Projection,
+                           viewport[2], viewport[3], Application::Get().GetFrameArena(),
+                           Application::Get().GetJobSystem());
+    BindLightGrid(*shader, *m_LightClusters);
+
+    for (const auto &draw : m_BodyDraws)
+    {
+        shader->UploadUniformMat4("model", draw.model);
+        shader->UploadUniformMat3("normalMatrix", draw.normalMatrix);
+        shader->UploadUniform1i("isSun", draw.isSun ? 1 : 0);
+        draw.texture->Bind();
+
+        DrawSphere();
+    }
+    shader->UnBind();
+
+    if (m_RenderSettings.depthPrePass)
+    {
+        GL_CALL(State, glDepthMask(GL_TRUE));
+        GL_CALL(State, glDepthFunc(GL_LESS));
+    }
+}
+
+void SolarSystemLayer::BindLightGrid(Shader &shader, const LightGrid &grid) const
+{
+    grid.BindTextures(GL_TEXTURE3);
+    shader.UploadUniform1i("lightData", 3);
+    shader.UploadUniform1i("clusterRanges", 4);
+    shader.UploadUniform1i("lightIndices", 5);
+    shader.UploadUniform1i("tileSize", static_cast<int>(grid.GetTileSize()));
+    shader.UploadUniform2i("tileCount", glm::ivec2(grid.GetTileCountX(), grid.GetTileCountY()));
+    shader.UploadUniform1i("depthSlices", static_cast<int>(grid.GetDepthSlices()));
+    shader.UploadUniform2f("sliceScaleBias", glm::vec2(grid.GetSliceScale(), grid.GetSliceBias()));
+}
+
+void SolarSystemLayer::BuildBodyDrawCommands()
+{
+    // last frame's lists point into an arena that is about to be reset, start over from the current one
+    FrameAllocator<BodyDrawCommand> allocator(Application::Get().GetFrameArena());
+    m_BodyDraws = FrameVector<BodyDrawCommand>(allocator);
+    m_ImpostorDraws = FrameVector<BodyDrawCommand>(allocator);
+    m_BodyDraws.reserve(m_CelestialBodies.size() + 1);
+    m_ImpostorDraws.reserve(m_CelestialBodies.size() + 1);
+    ResourceManager &resources = Application::Get().GetResourceManager();
+
+    // framebuffer pixels, the window size is in points and differs on Retina displays
+    GLint viewport[4];
+    GL_CALL(Other, glGetIntegerv(GL_VIEWPORT, viewport));
+    float viewportHeight = static_cast<float>(viewport[3]);
+
+    auto addBody = [this, viewportHeight](const glm::mat4 &model, Texture *texture, bool isSun)
+    {
+        if (m_RenderSettings.impostors && IsImpostor(model, viewportHeight))
+        {
+            m_ImpostorDraws.push_back({model, glm::mat3(1.0f), texture, isSun});
+            return;
+        }
+
+        // one 3x3 inverse per body here instead of a 4x4 inverse per vertex in the shader
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+        m_BodyDraws.push_back({model, normalMatrix, texture, isSun});
+    };
+
     for (unsigned int i = 0; i < m_CelestialBodies.size(); i++)
     {
         m_Model = glm::mat4(1.0f);
@@ -249,15 +423,7 @@ void SolarSystemLayer::OnRender()
         m_Model = glm::scale(m_Model, glm::vec3(m_CelestialBodies.at(i).size));
         m_Model = glm::rotate(m_Model, glm::radians(m_CelestialBodies.at(i).axialTilt), glm::vec3(1.0f, 0.0f, 0.0f));
         m_Model = glm::rotate(m_Model, glm::radians(m_Time * m_CelestialBodies.at(i).rotationSpeed), glm::vec3(0.0f, 1.0f, 0.0f));
-        shader->UploadUniformMat4("model", m_Model);
-        shader->UploadUniform1i("isSun", (i == 0) ? 1 : 0);
-
-        Texture *texture = m_TextureManager->GetTexture(m_TextureNames.at(i));
-        texture->Bind();
-
-        m_VAO->Bind();
-        glDrawElements(GL_TRIANGLES, m_EBO->GetCount(), GL_UNSIGNED_INT, 0);
-        m_VAO->UnBind();
+        addBody(m_Model, resources.Get(m_BodyTextures.at(i)), i == 0);
 
         // Render moon orbiting Earth
         if (i == 3) // Earth index
@@ -268,25 +434,272 @@ void SolarSystemLayer::OnRender()
             float z = 2.0f * sin(moonAngle);
             moonModel = glm::translate(moonModel, glm::vec3(x, 0.0f, z));
             moonModel = glm::scale(moonModel, glm::vec3(0.27f));
+            addBody(moonModel, resources.Get(m_MoonTexture), false);
+        }
+    }
+}
 
-            shader->UploadUniformMat4("model", moonModel);
-            shader->UploadUniform1i("isSun", (i == 0) ? 1 : 0);
+bool SolarSystemLayer::IsImpostor(const glm::mat4 &model, float viewportHeight) const
+{
+    // bodies are uniformly scaled unit spheres, so the first column carries the scale
+    glm::vec3 center = glm::vec3(model[3]);
+    float radius = SPHERE_RADIUS * glm::length(glm::vec3(model[0]));
+    float distance = glm::length(center - m_Camera.GetPosition());
+    if (distance <= radius * 2.0f)
+        return false;
+
+    // projected radius in pixels, m_Projection[1][1] = 1 / tan(fov / 2)
+    float pixelRadius = radius / distance * m_Projection[1][1] * 0.5f * viewportHeight;
+    return pixelRadius < m_RenderSettings.impostorPixelThreshold;
+}
 
-            Texture *texture = m_TextureManager->GetTexture("moon");
-            texture->Bind();
+void SolarSystemLayer::DrawImpostors()
+{
+    auto *shader = GetShader(IMPOSTOR_SHADER);
 
-            m_VAO->Bind();
-            glDrawElements(GL_TRIANGLES, m_EBO->GetCount(), GL_UNSIGNED_INT, 0);
-            m_VAO->UnBind();
-        }
+    shader->UseProgram();
+    shader->UploadUniformMat4("view", m_View);
+    shader->UploadUniformMat4("projection", m_Projection);
+    shader->UploadUniform3f("lightPos", m_LightPosition);
+    shader->UploadUniform3f("viewPos", m_Camera.GetPosition());
+    shader->UploadUniform3f("lightColor", m_LightColor);
+
+    // same point lights as the meshes around them, both grids are built earlier in the frame
+    BindLightGrid(*shader, m_RenderSettings.deferredShading ? *m_LightGrid : *m_LightClusters);
+
+    // all instances written with one map, the fence keeps regions the GPU still reads untouched
+    m_ImpostorInstances->BeginFrame();
+    GLsizeiptr stride = m_ImpostorInstances->GetLayout().GetStride();
+    StreamingAllocation allocation = m_ImpostorInstances->Map(m_ImpostorDraws.size() * stride);
+    if (!allocation.m_Data)
+    {
+        m_ImpostorInstances->EndFrame();
+        shader->UnBind();
+        return;
+    }
+
+    auto *instances = static_cast<ImpostorInstance *>(allocation.m_Data);
+    for (std::size_t i = 0; i < m_ImpostorDraws.size(); i++)
+    {
+        const glm::mat4 &model = m_ImpostorDraws[i].model;
+        float scale = glm::length(glm::vec3(model[0]));
+        instances[i] = {glm::vec4(glm::vec3(model[3]), SPHERE_RADIUS * scale),
+                        glm::mat3(glm::normalize(glm::vec3(model[0])),
+                                  glm::normalize(glm::vec3(model[1])),
+                                  glm::normalize(glm::vec3(model[2]))),
+                        m_ImpostorDraws[i].isSun ? 1 : 0};
+    }
+    m_ImpostorInstances->Unmap();
+
+    // every body has its own texture and GL 4.1 has no base instance, so each draw re-points
+    // the instance attributes at its slot of the ring
+    m_ImpostorVAO->Bind();
+    for (std::size_t i = 0; i < m_ImpostorDraws.size(); i++)
+    {
+        m_ImpostorVAO->SetStreamingOffset(m_ImpostorInstances, allocation.m_Offset + i * stride);
+        m_ImpostorDraws[i].texture->Bind();
+
+        GL_CALL(Draw, glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, 1));
+        FrameStats::CountDraw(GL_TRIANGLE_STRIP, 4);
+    }
+    m_ImpostorVAO->UnBind();
+    m_ImpostorInstances->EndFrame();
+
+    shader->UnBind();
+}
+
+void SolarSystemLayer::GeneratePointLights(int count)
+{
+    m_PointLights.clear();
+    m_PointLightOrbits.clear();
+
+    for (int i = 0; i < count; i++)
+    {
+        // deterministic spread between Mercury and Pluto, hues cycle around the color wheel
+        float t = static_cast<float>(i) / count;
+        float hue = glm::fract(t * 7.0f) * 6.0f;
+        glm::vec3 color = glm::clamp(glm::vec3(std::abs(hue - 3.0f) - 1.0f,
+                                               2.0f - std::abs(hue - 2.0f),
+                                               2.0f - std::abs(hue - 4.0f)),
+                                     0.0f, 1.0f);
+
+        m_PointLightOrbits.push_back({25.0f + 155.0f * glm::fract(t * 13.0f),
+                                      -3.0f + 6.0f * glm::fract(t * 5.0f),
+                                      0.2f + 0.8f * glm::fract(t * 3.0f),
+                                      t * 2.0f * static_cast<float>(M_PI)});
+        m_PointLights.push_back({glm::vec3(0.0f), 12.0f, color, 2.0f});
+    }
+}
+
+void SolarSystemLayer::UpdatePointLights()
+{
+    // independent per light, split into chunks across the job system
+    Application::Get().GetJobSystem().ParallelFor(static_cast<uint32_t>(m_PointLights.size()), 64,
+                                                  [this](uint32_t begin, uint32_t end)
+                                                  {
+                                                      for (uint32_t i = begin; i < end; i++)
+                                                      {
+                                                          const PointLightOrbit &orbit = m_PointLightOrbits[i];
+                                                          float angle = orbit.phase + m_Time * orbit.speed * m_OrbitalSpeedScale;
+                                                          m_PointLights[i].position = glm::vec3(orbit.radius * cos(angle), orbit.height,
+                                                                                                orbit.radius * sin(angle));
+                                                      } },
+                                                  "UpdatePointLights");
+}
+
+std::size_t SolarSystemLayer::GetActivePointLightCount() const
+{
+    // only the lights switched on in the overlay take part in binning
+    return std::min<std::size_t>(std::max(m_RenderSettings.pointLightCount, 0), m_PointLights.size());
+}
+
+void SolarSystemLayer::RenderGeometryPass()
+{
+    GLint viewport[4];
+    GL_CALL(Other, glGetIntegerv(GL_VIEWPORT, viewport));
+    m_GBuffer->Resize(viewport[2], viewport[3]);
+
+    m_GBuffer->Bind();
+    GL_CALL(Draw, glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+
+    auto *shader = GetShader(GBUFFER_SHADER);
+    shader->UseProgram();
+    shader->UploadUniformMat4("view", m_View);
+    shader->UploadUniformMat4("projection", m_Projection);
+
+    for (const auto &draw : m_BodyDraws)
+    {
+        shader->UploadUniformMat4("model", draw.model);
+        shader->UploadUniformMat3("normalMatrix", draw.normalMatrix);
+        shader->UploadUniform1i("isSun", draw.isSun ? 1 : 0);
+        draw.texture->Bind();
+
+        DrawSphere();
     }
     shader->UnBind();
+
+    m_GBuffer->UnBind();
+}
+
+void SolarSystemLayer::RenderLightingPass()
+{
+    m_LightGrid->Build(m_PointLights.data(), GetActivePointLightCount(), m_View, m_Projection,
+                       m_GBuffer->GetWidth(), m_GBuffer->GetHeight(), Application::Get().GetFrameArena(),
+                       Application::Get().GetJobSystem());
+
+    auto *shader = GetShader(DEFERRED_LIGHTING_SHADER);
+    shader->UseProgram();
+
+    m_GBuffer->BindTextures(GL_TEXTURE0);
+    m_LightGrid->BindTextures(GL_TEXTURE3);
+    shader->UploadUniform1i("gAlbedo", 0);
+    shader->UploadUniform1i("gNormal", 1);
+    shader->UploadUniform1i("gDepth", 2);
+    shader->UploadUniform1i("lightData", 3);
+    shader->UploadUniform1i("clusterRanges", 4);
+    shader->UploadUniform1i("lightIndices", 5);
+
+    shader->UploadUniformMat4("inverseViewProjection", glm::inverse(m_Projection * m_View));
+    shader->UploadUniform3f("viewPos", m_Camera.GetPosition());
+    shader->UploadUniform3f("lightPos", m_LightPosition);
+    shader->UploadUniform3f("lightColor", m_LightColor);
+    shader->UploadUniform1i("tileSize", static_cast<int>(m_LightGrid->GetTileSize()));
+    shader->UploadUniform1i("tileCountX", static_cast<int>(m_LightGrid->GetTileCountX()));
+
+    // fullscreen triangle, writes G-buffer depth so later forward passes still depth test against the bodies
+    m_EmptyVAO->Bind();
+    GL_CALL(Draw, glDrawArrays(GL_TRIANGLES, 0, 3));
+    FrameStats::CountDraw(GL_TRIANGLES, 3);
+    m_EmptyVAO->UnBind();
+
+    shader->UnBind();
+}
+
+void SolarSystemLayer::DrawSphere() const
+{
+    GLsizei vertexCount = m_ProceduralGeometry ? SPHERE_SECTORS * SPHERE_STACKS * 6 : m_EBO->GetCount();
+
+    m_VAO->Bind();
+    if (m_ProceduralGeometry)
+        GL_CALL(Draw, glDrawArrays(GL_TRIANGLES, 0, vertexCount));
+    else
+        GL_CALL(Draw, glDrawElements(GL_TRIANGLES, vertexCount, GL_UNSIGNED_INT, 0));
+    FrameStats::CountDraw(GL_TRIANGLES, vertexCount);
+    m_VAO->UnBind();
+}
+
+void SolarSystemLayer::CreateMeshGeometry()
+{
+    // CPU generated, only kept alive until uploaded
+    std::vector<float> sphereVertices;
+    std::vector<unsigned int> sphereIndices;
+    std::vector<float> orbitLineVertices;
+
+    GenerateSphere(sphereVertices, sphereIndices, SPHERE_RADIUS, SPHERE_SECTORS, SPHERE_STACKS);
+    for (const auto &body : m_CelestialBodies)
+    {
+        // first/count ranges so every orbit is drawn by a single glMultiDrawArrays
+        m_OrbitFirsts.push_back(static_cast<GLint>(orbitLineVertices.size() / 3));
+        m_OrbitCounts.push_back(ORBIT_SEGMENTS + 1);
+        GenerateOrbitLine(orbitLineVertices, body.orbitalRadius, ORBIT_SEGMENTS);
+    }
+
+    // orbit line layout, vertex buffer, and vertex array
+    BufferLayout orbitLayout = {{BufferAttributeType::Vec3, "aPos"}};
+
+    m_OrbitVAO = VertexArray::Create();
+    m_OrbitVBO = VertexBuffer::Create(orbitLineVertices);
+    m_OrbitVBO->SetLayout(orbitLayout);
+    m_OrbitVAO->AddVertexBuffer(m_OrbitVBO);
+
+    BufferLayout layout = {
+        {BufferAttributeType::Vec3, "aPos"},
+        {BufferAttributeType::Vec3, "aNormal"},
+        {BufferAttributeType::Vec2, "aTexCoords"},
+    };
+
+    m_VAO = VertexArray::Create();
+    m_VBO = VertexBuffer::Create(sphereVertices);
+    m_EBO = IndexBuffer::Create(sphereIndices);
+    m_VBO->SetLayout(layout);
+    m_VAO->AddVertexBuffer(m_VBO);
+    m_VAO->SetIndexBuffer(m_EBO);
 }
 
-bool SolarSystemLayer::OnMouseMove(MouseMovedEvent &e)
+void SolarSystemLayer::CreateProceduralGeometry()
 {
-    Logger::Debug("Mouse Position: ({}, {})", e.GetX(), e.GetY());
-    return true;
+    // per-instance shape parameters only, positions come from gl_VertexID in the shaders
+    struct ShapeInstance
+    {
+        float radius;
+        int segments[2];
+    };
+
+    std::vector<ShapeInstance> orbits;
+    for (const auto &body : m_CelestialBodies)
+        orbits.push_back({body.orbitalRadius, {ORBIT_SEGMENTS, 0}});
+
+    BufferLayout shapeLayout(
+        {
+            {BufferAttributeType::Vec, "aRadius"},
+            {BufferAttributeType::iVec2, "aSegments"},
+        },
+        1);
+
+    m_OrbitVAO = VertexArray::Create();
+    m_OrbitVBO = VertexBuffer::Create(static_cast<uint32_t>(orbits.size() * sizeof(ShapeInstance)));
+    m_OrbitVBO->SetData(orbits.data(), static_cast<uint32_t>(orbits.size() * sizeof(ShapeInstance)));
+    m_OrbitVBO->SetLayout(shapeLayout);
+    m_OrbitVAO->AddVertexBuffer(m_OrbitVBO);
+
+    // a single instance, non-instanced draws read instance 0
+    ShapeInstance sphere = {SPHERE_RADIUS, {SPHERE_SECTORS, SPHERE_STACKS}};
+
+    m_VAO = VertexArray::Create();
+    m_VBO = VertexBuffer::Create(static_cast<uint32_t>(sizeof(ShapeInstance)));
+    m_VBO->SetData(&sphere, sizeof(ShapeInstance));
+    m_VBO->SetLayout(shapeLayout);
+    m_VAO->AddVertexBuffer(m_VBO);
 }
 
 void SolarSystemLayer::GenerateSphere(std::vector<float> &vertices, std::vector<unsigned int> &indices, float radius, int sectorCount, int stackCount)
@@ -2,10 +2,11 @@
 
 int main(int argc, char **argv)
 {
-    Application *app = new Application();
+    Application *app = new Application(argc, argv);
     app->Run();
+    int exitCode = app->GetExitCode();
 
     delete app;
 
-    return 0;
+    return exitCode;
 }
\ No newline at end of file